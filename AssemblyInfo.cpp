@@ -1,5 +1,6 @@
 ﻿using namespace System;
 using namespace System::Reflection;
+using namespace System::Runtime::CompilerServices;
 
 // The file encoding has to be UTF-8 with BOM and literal strings have to be wstring so the ANSI encoding won't have influence on the literal strings
 [assembly:AssemblyTitle(L"Community Script Hook V .NET")];
@@ -12,3 +13,5 @@ using namespace System::Reflection;
 // Sign with a strong name to distinguish from older versions and cause .NET framework runtime to bind the correct assemblies
 // There is no version check performed for assemblies without strong names (https://docs.microsoft.com/en-us/dotnet/framework/deployment/how-the-runtime-locates-assemblies)
 [assembly:AssemblyKeyFileAttribute(L"PublicKeyToken.snk")];
+// Let the benchmarks in source/benchmarks measure internals such as the script tick and the pool scans (they are signed with the same key)
+[assembly:InternalsVisibleTo(L"ScriptHookVDotNet_Benchmarks, PublicKey=0024000004800000940000000602000000240000525341310004000001000100a1d07691d9f09c7392ab20e0d991190ac6b7e20007fab9f50224c791649a8cb2399ab5354dc45996914de0332dd7dd5e3580db4ca3e0d8318ce46522598d5d26c299e9eb7d312a9827c578e08b74f0f485d1f5dee875dafe4e72116dc588f6750d1b1f09e5d3a82ca83a75c75ce903631c4e8e34d16b33a8db5fba98e34aa2c9")];
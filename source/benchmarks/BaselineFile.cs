@@ -0,0 +1,90 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+
+namespace ScriptHookVDotNet_Benchmarks
+{
+    /// <summary>
+    /// Reads and writes the mean times of the benchmarks, so runs can be compared for regressions.
+    /// </summary>
+    /// <remarks>
+    /// The file is a tab-separated list of benchmark names and mean times in nanoseconds, one benchmark per line.
+    /// Tabs are used because benchmark names contain commas for their parameters.
+    /// </remarks>
+    internal static class BaselineFile
+    {
+        internal static Dictionary<string, double> Read(string path)
+        {
+            var results = new Dictionary<string, double>();
+            foreach (string line in File.ReadAllLines(path))
+            {
+                if (line.Length == 0 || line[0] == '#')
+                {
+                    continue;
+                }
+
+                int separatorIndex = line.LastIndexOf('\t');
+                if (separatorIndex < 0 ||
+                    !double.TryParse(line.Substring(separatorIndex + 1), NumberStyles.Float, CultureInfo.InvariantCulture, out double mean))
+                {
+                    continue;
+                }
+
+                results[line.Substring(0, separatorIndex)] = mean;
+            }
+
+            return results;
+        }
+
+        /// <summary>
+        /// Replaces the results in the file, keeping the comments of an existing file such as notes on the machine the
+        /// results were recorded on.
+        /// </summary>
+        internal static void Write(string path, Dictionary<string, double> results)
+        {
+            string[] comments = File.Exists(path) ? File.ReadAllLines(path).Where(x => x.Length != 0 && x[0] == '#').ToArray() : Array.Empty<string>();
+            if (comments.Length == 0)
+            {
+                comments = new[] { "# Mean times in nanoseconds, written by --update-baseline" };
+            }
+
+            IEnumerable<string> lines = results
+                .OrderBy(x => x.Key, StringComparer.Ordinal)
+                .Select(x => x.Key + "\t" + x.Value.ToString("R", CultureInfo.InvariantCulture));
+
+            File.WriteAllLines(path, comments.Concat(lines));
+        }
+
+        /// <summary>
+        /// Prints how each benchmark changed compared to the baseline.
+        /// </summary>
+        /// <returns><see langword="true" /> if no benchmark got slower by more than <paramref name="thresholdPercent"/>.</returns>
+        internal static bool Compare(Dictionary<string, double> baseline, Dictionary<string, double> results, double thresholdPercent)
+        {
+            bool passed = true;
+            foreach (KeyValuePair<string, double> result in results.OrderBy(x => x.Key, StringComparer.Ordinal))
+            {
+                if (!baseline.TryGetValue(result.Key, out double baselineMean) || baselineMean <= 0)
+                {
+                    Console.WriteLine($"[new]        {result.Key}: {result.Value:F2} ns");
+                    continue;
+                }
+
+                double changePercent = (result.Value - baselineMean) / baselineMean * 100.0;
+                bool regressed = changePercent > thresholdPercent;
+                passed &= !regressed;
+
+                Console.WriteLine($"{(regressed ? "[regressed]" : "[ok]"),-12} {result.Key}: {baselineMean:F2} ns -> {result.Value:F2} ns ({changePercent:+0.0;-0.0}%)");
+            }
+
+            return passed;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using BenchmarkDotNet.Attributes;
+using System;
+using System.Runtime.InteropServices;
+
+namespace ScriptHookVDotNet_Benchmarks
+{
+    /// <summary>
+    /// Measures the pattern scans <c>NativeMemory</c> runs at startup, over a synthetic region of random bytes with the
+    /// pattern at the very end, which is the worst case for both algorithms.
+    /// </summary>
+    public unsafe class MemScannerBenchmarks
+    {
+        // Taken from the patterns NativeMemory scans for, with and without wildcards
+        private const string ShortPattern = "\x4C\x8D\x05\x00\x00\x00\x00\x0F\xB7\xC1";
+        private const string ShortMask = "xxx????xxx";
+        private const string LongPattern = "\x74\x27\x48\x8D\x7E\x18\x48\x8B\x0F\x48\x3B\xCB\x74\x1B";
+        private const string LongMask = "xxxxxxxxxxxxxx";
+
+        private IntPtr _region;
+        private ulong _regionSize;
+
+        /// <summary>
+        /// The size of the scanned region in MiB. GTA5.exe takes roughly 60 MiB in memory.
+        /// </summary>
+        [Params(16, 64)]
+        public int RegionSizeInMiB { get; set; }
+
+        [Params(false, true)]
+        public bool UseLongPattern { get; set; }
+
+        private string Pattern => UseLongPattern ? LongPattern : ShortPattern;
+        private string Mask => UseLongPattern ? LongMask : ShortMask;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _regionSize = (ulong)RegionSizeInMiB << 20;
+            _region = Marshal.AllocHGlobal((IntPtr)(long)_regionSize);
+
+            // Fixed seed, so every run scans the same bytes
+            var random = new Random(12345);
+            var bytes = new byte[_regionSize];
+            random.NextBytes(bytes);
+
+            string pattern = Pattern;
+            for (int i = 0; i < pattern.Length; i++)
+            {
+                bytes[bytes.Length - pattern.Length + i] = (byte)pattern[i];
+            }
+
+            Marshal.Copy(bytes, 0, _region, bytes.Length);
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            Marshal.FreeHGlobal(_region);
+        }
+
+        [Benchmark(Baseline = true)]
+        public IntPtr Naive() => (IntPtr)SHVDN.MemScanner.FindPatternNaive(Pattern, Mask, _region, _regionSize);
+
+        [Benchmark]
+        public IntPtr BoyerMooreHorspool() => (IntPtr)SHVDN.MemScanner.FindPatternBmh(Pattern, Mask, _region, _regionSize);
+    }
+}
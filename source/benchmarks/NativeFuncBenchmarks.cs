@@ -0,0 +1,72 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using BenchmarkDotNet.Attributes;
+using System;
+using System.Runtime.InteropServices;
+
+namespace ScriptHookVDotNet_Benchmarks
+{
+    /// <summary>
+    /// Measures the per-call overhead of the script function invocation paths, with the stub ScriptHookV doing
+    /// (almost) no work for the function itself.
+    /// </summary>
+    [MemoryDiagnoser]
+    public unsafe class NativeFuncBenchmarks
+    {
+        // GET_ENTITY_COORDS, which takes 2 arguments and returns a vector
+        private const ulong GetEntityCoordsHash = 0x3FEF770D40960D5A;
+        // GET_GAME_TIMER, which is not registered to the stub and just returns zero
+        private const ulong GetGameTimerHash = 0x9CD27B0045628463;
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate void StubNativeHandler(ulong* args, int argCount, ulong* result);
+
+        [DllImport("ScriptHookV.dll", ExactSpelling = true)]
+        private static extern void stubRegisterNative(ulong hash, IntPtr handler);
+
+        // Keep the delegate alive as long as the stub can call it
+        private static readonly StubNativeHandler s_getEntityCoordsHandler = GetEntityCoords;
+
+        private ulong* _argumentBuffer;
+        private readonly ulong[] _argumentArray = { 1, 0 };
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            stubRegisterNative(GetEntityCoordsHash, Marshal.GetFunctionPointerForDelegate(s_getEntityCoordsHandler));
+
+            _argumentBuffer = (ulong*)Marshal.AllocHGlobal(sizeof(ulong) * 2);
+            _argumentBuffer[0] = 1;
+            _argumentBuffer[1] = 0;
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            stubRegisterNative(GetEntityCoordsHash, IntPtr.Zero);
+            Marshal.FreeHGlobal((IntPtr)_argumentBuffer);
+        }
+
+        private static void GetEntityCoords(ulong* args, int argCount, ulong* result)
+        {
+            ((float*)result)[0] = 1.0f;
+            ((float*)result)[2] = 2.0f;
+            ((float*)result)[4] = 3.0f;
+        }
+
+        [Benchmark(Baseline = true)]
+        public ulong NoArguments() => *SHVDN.NativeFunc.InvokeInternal(GetGameTimerHash, null, 0);
+
+        [Benchmark]
+        public ulong ArgumentPointer() => *SHVDN.NativeFunc.InvokeInternal(GetEntityCoordsHash, _argumentBuffer, 2);
+
+        [Benchmark]
+        public ulong ArgumentArray() => *SHVDN.NativeFunc.InvokeInternal(GetEntityCoordsHash, _argumentArray);
+
+        [Benchmark]
+        public ulong BoxedArguments() => *SHVDN.NativeFunc.InvokeInternal(GetEntityCoordsHash, new object[] { 1, false });
+    }
+}
@@ -0,0 +1,96 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using BenchmarkDotNet.Attributes;
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using static SHVDN.NativeMemory.PathFind;
+
+namespace ScriptHookVDotNet_Benchmarks
+{
+    /// <summary>
+    /// Measures the vehicle node queries of <c>PathFind</c> over one synthetic path region, which is what they run for
+    /// each region in range.
+    /// </summary>
+    /// <remarks>
+    /// The static constructor of <c>PathFind</c> scans the benchmark executable for <c>CPathFind</c> and finds nothing,
+    /// which is harmless since the region is passed directly.
+    /// </remarks>
+    public unsafe class PathFindBenchmarks
+    {
+        // The center of the region, which covers 512 x 512 meters like a ynd file
+        private const float CenterX = 256f;
+        private const float CenterY = 256f;
+        private const float CenterZ = 30f;
+
+        private static readonly Func<int, bool> s_highwayPredicate = flags => (flags & (int)VehiclePathNodeProperties.Highway) != 0;
+
+        private IntPtr _region;
+        private IntPtr _nodes;
+        private readonly List<int> _result = new();
+
+        /// <summary>
+        /// The number of vehicle nodes in the region. A vanilla ynd file has about 100 to 1500 nodes.
+        /// </summary>
+        [Params(1500)]
+        public int NodeCount { get; set; }
+
+        [Params(50f, 500f)]
+        public float Radius { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _nodes = Marshal.AllocHGlobal(NodeCount * sizeof(CPathNode));
+            _region = Marshal.AllocHGlobal(sizeof(CPathRegion));
+
+            var region = (CPathRegion*)_region;
+            *region = default;
+            region->NodeArrayPtr = _nodes;
+            region->NodeCount = (uint)NodeCount;
+            region->NodeCountVehicle = (uint)NodeCount;
+
+            // Fixed seed, so every run queries the same nodes
+            var random = new Random(12345);
+            for (int i = 0; i < NodeCount; i++)
+            {
+                CPathNode* node = region->GetPathNodeUnsafe((uint)i);
+                *node = default;
+                node->NodeId = (ushort)i;
+                node->PositionX = (short)(random.Next(512) * 4);
+                node->PositionY = (short)(random.Next(512) * 4);
+                node->PositionZ = (short)(random.Next(10, 50) * 32);
+                node->Flags1 = (ushort)random.Next(0x10000);
+                node->Flags2 = (byte)random.Next(0x100);
+                node->Flags4 = (byte)random.Next(0x100);
+                node->Flag5AndDensity = (byte)random.Next(0x100);
+            }
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            Marshal.FreeHGlobal(_region);
+            Marshal.FreeHGlobal(_nodes);
+        }
+
+        [Benchmark(Baseline = true)]
+        public int VehicleNodesInRange()
+        {
+            _result.Clear();
+            ((CPathRegion*)_region)->AddVehicleNodesInRange(_result, CenterX, CenterY, CenterZ, Radius, null);
+            return _result.Count;
+        }
+
+        [Benchmark]
+        public int HighwayVehicleNodesInRange()
+        {
+            _result.Clear();
+            ((CPathRegion*)_region)->AddVehicleNodesInRange(_result, CenterX, CenterY, CenterZ, Radius, s_highwayPredicate);
+            return _result.Count;
+        }
+    }
+}
@@ -0,0 +1,143 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using BenchmarkDotNet.Attributes;
+using System;
+using System.Runtime.InteropServices;
+using static SHVDN.NativeMemory;
+
+namespace ScriptHookVDotNet_Benchmarks
+{
+    /// <summary>
+    /// Measures the slot scans over <c>rage::fwBasePool</c> (peds, objects, buildings) and
+    /// <c>rage::sysMemPoolAllocator</c> (vehicles), over synthetic pools laid out like the ones in the game.
+    /// </summary>
+    /// <remarks>
+    /// Only the pool structs are used, which does not run the static constructor of <c>NativeMemory</c>, so nothing
+    /// here needs the game executable.
+    /// </remarks>
+    public unsafe class PoolScanBenchmarks
+    {
+        private IntPtr _fwBasePool;
+        private IntPtr _fwBasePoolItems;
+        private IntPtr _fwBasePoolByteArray;
+        private IntPtr _poolAllocator;
+        private IntPtr _poolAllocatorSlots;
+        private IntPtr _poolAllocatorBitArray;
+        private ulong[] _addresses;
+
+        /// <summary>
+        /// The number of slots in each pool. The ped pool has 256 slots and the object pool 2300 in the vanilla game.
+        /// </summary>
+        [Params(256, 2048)]
+        public int PoolSize { get; set; }
+
+        /// <summary>
+        /// The percentage of used slots, which are spread randomly over the pool.
+        /// </summary>
+        [Params(25, 90)]
+        public int UsedPercentage { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            const int ItemSize = 0x100;
+
+            // Fixed seed, so every run scans the same slots
+            var random = new Random(12345);
+            bool[] used = new bool[PoolSize];
+            int usedCount = 0;
+            for (int i = 0; i < used.Length; i++)
+            {
+                used[i] = random.Next(100) < UsedPercentage;
+                usedCount += used[i] ? 1 : 0;
+            }
+
+            _fwBasePoolItems = Marshal.AllocHGlobal(PoolSize * ItemSize);
+            _fwBasePoolByteArray = Marshal.AllocHGlobal(PoolSize);
+            _fwBasePool = AllocZeroed(0x30);
+            var fwBasePool = (FwBasePool*)_fwBasePool;
+            fwBasePool->poolStartAddress = (ulong)_fwBasePoolItems.ToInt64();
+            fwBasePool->byteArray = _fwBasePoolByteArray;
+            fwBasePool->size = (uint)PoolSize;
+            fwBasePool->itemSize = ItemSize;
+            fwBasePool->itemCount = (ushort)usedCount;
+            // The high bit marks a free slot and the rest is the reuse counter of the slot
+            byte* byteArray = (byte*)_fwBasePoolByteArray;
+            for (int i = 0; i < PoolSize; i++)
+            {
+                byteArray[i] = (byte)((used[i] ? 0 : 0x80) | random.Next(0x80));
+            }
+
+            _poolAllocatorSlots = Marshal.AllocHGlobal(PoolSize * sizeof(ulong));
+            _poolAllocatorBitArray = AllocZeroed((PoolSize + 31) / 32 * sizeof(uint));
+            _poolAllocator = AllocZeroed(0x78);
+            var poolAllocator = (RageSysMemPoolAllocator*)_poolAllocator;
+            poolAllocator->poolAddress = (ulong*)_poolAllocatorSlots;
+            poolAllocator->size = (uint)PoolSize;
+            poolAllocator->bitArray = (uint*)_poolAllocatorBitArray;
+            poolAllocator->itemCount = (uint)usedCount;
+            for (int i = 0; i < PoolSize; i++)
+            {
+                poolAllocator->poolAddress[i] = used[i] ? (ulong)_fwBasePoolItems.ToInt64() + (ulong)(i * ItemSize) : 0;
+                if (used[i])
+                {
+                    poolAllocator->bitArray[i >> 5] |= 1u << (i & 0x1F);
+                }
+            }
+
+            _addresses = new ulong[PoolSize];
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            Marshal.FreeHGlobal(_fwBasePool);
+            Marshal.FreeHGlobal(_fwBasePoolItems);
+            Marshal.FreeHGlobal(_fwBasePoolByteArray);
+            Marshal.FreeHGlobal(_poolAllocator);
+            Marshal.FreeHGlobal(_poolAllocatorSlots);
+            Marshal.FreeHGlobal(_poolAllocatorBitArray);
+        }
+
+        [Benchmark(Baseline = true)]
+        public int FwBasePoolAddresses() => ((FwBasePool*)_fwBasePool)->CopyAddresses(_addresses, 0);
+
+        /// <summary>
+        /// The scan that <c>GetHandlesInFwBasePool</c> runs to get the handles of buildings and interiors.
+        /// </summary>
+        [Benchmark]
+        public int FwBasePoolGuidHandles()
+        {
+            var pool = (FwBasePool*)_fwBasePool;
+
+            int checksum = 0;
+            uint poolSize = pool->size;
+            for (uint i = 0; i < poolSize; i++)
+            {
+                if (pool->IsValid(i))
+                {
+                    checksum += pool->GetGuidHandleByIndex(i);
+                }
+            }
+
+            return checksum;
+        }
+
+        [Benchmark]
+        public int RageSysMemPoolAllocatorAddresses() => ((RageSysMemPoolAllocator*)_poolAllocator)->CopyAddresses(_addresses, 0);
+
+        private static IntPtr AllocZeroed(int size)
+        {
+            IntPtr memory = Marshal.AllocHGlobal(size);
+            for (int i = 0; i < size; i++)
+            {
+                ((byte*)memory)[i] = 0;
+            }
+
+            return memory;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using BenchmarkDotNet.Configs;
+using BenchmarkDotNet.Diagnosers;
+using BenchmarkDotNet.Jobs;
+using BenchmarkDotNet.Reports;
+using BenchmarkDotNet.Running;
+using BenchmarkDotNet.Toolchains.InProcess.Emit;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+
+namespace ScriptHookVDotNet_Benchmarks
+{
+    /// <summary>
+    /// Runs the benchmarks against the real ScriptHookVDotNet.asi with the stub ScriptHookV.dll, outside the game.
+    /// </summary>
+    /// <remarks>
+    /// Besides the options of BenchmarkDotNet, the following options are supported:
+    /// <list type="bullet">
+    /// <item><c>--baseline &lt;file&gt;</c>: Compares the results with the file and exits with 1 if any benchmark regressed (default: baseline.csv).</item>
+    /// <item><c>--update-baseline</c>: Writes the results to the baseline file instead of comparing them.</item>
+    /// <item><c>--threshold &lt;percent&gt;</c>: How much slower a benchmark may get before it counts as a regression (default: 10).</item>
+    /// </list>
+    /// </remarks>
+    public static class Program
+    {
+        public static int Main(string[] args)
+        {
+            // The asi file is not probed like a dll, so resolve it manually
+            AppDomain.CurrentDomain.AssemblyResolve += (sender, e) =>
+            {
+                if (new AssemblyName(e.Name).Name != "ScriptHookVDotNet")
+                {
+                    return null;
+                }
+
+                string path = Path.Combine(AppDomain.CurrentDomain.BaseDirectory, "ScriptHookVDotNet.asi");
+                return File.Exists(path) ? Assembly.LoadFrom(path) : null;
+            };
+
+            var benchmarkArgs = new List<string>();
+            string baselinePath = Path.Combine(AppDomain.CurrentDomain.BaseDirectory, "baseline.csv");
+            bool updateBaseline = false;
+            double threshold = 10.0;
+            for (int i = 0; i < args.Length; i++)
+            {
+                switch (args[i])
+                {
+                    case "--baseline" when i + 1 < args.Length:
+                        baselinePath = args[++i];
+                        break;
+                    case "--update-baseline":
+                        updateBaseline = true;
+                        break;
+                    case "--threshold" when i + 1 < args.Length:
+                        threshold = double.Parse(args[++i], System.Globalization.CultureInfo.InvariantCulture);
+                        break;
+                    default:
+                        benchmarkArgs.Add(args[i]);
+                        break;
+                }
+            }
+
+            // Run in this process, since the assembly resolve handler and the stub only exist here
+            IConfig config = DefaultConfig.Instance
+                .AddJob(Job.Default.WithToolchain(InProcessEmitToolchain.Instance))
+                .AddDiagnoser(MemoryDiagnoser.Default);
+
+            Summary[] summaries = BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(benchmarkArgs.ToArray(), config).ToArray();
+            Dictionary<string, double> results = summaries
+                .SelectMany(x => x.Reports)
+                .Where(x => x.ResultStatistics != null)
+                .ToDictionary(x => GetBaselineKey(x.BenchmarkCase), x => x.ResultStatistics.Mean);
+
+            if (updateBaseline)
+            {
+                BaselineFile.Write(baselinePath, results);
+                Console.WriteLine($"Wrote {results.Count} results to {baselinePath}.");
+                return 0;
+            }
+
+            if (!File.Exists(baselinePath))
+            {
+                Console.WriteLine($"No baseline at {baselinePath}. Run with --update-baseline on the reference machine to record one.");
+                return 0;
+            }
+
+            return BaselineFile.Compare(BaselineFile.Read(baselinePath), results, threshold) ? 0 : 1;
+        }
+
+        /// <summary>
+        /// Gets the name of a benchmark in the baseline file, which leaves out the job so the checked-in baseline does
+        /// not depend on the job id BenchmarkDotNet generates.
+        /// </summary>
+        private static string GetBaselineKey(BenchmarkCase benchmarkCase)
+        {
+            string parameters = benchmarkCase.Parameters.DisplayInfo;
+            return parameters.Length == 0 ? benchmarkCase.Descriptor.DisplayInfo : benchmarkCase.Descriptor.DisplayInfo + " " + parameters;
+        }
+    }
+}
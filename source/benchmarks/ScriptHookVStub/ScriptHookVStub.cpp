@@ -0,0 +1,129 @@
+/**
+ * Copyright (C) 2015 crosire & kagikn & contributors
+ * License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+ */
+
+// A stand-in for ScriptHookV.dll that lets ScriptHookVDotNet.asi be loaded outside the game, so the benchmarks can
+// run the real SHVDN code paths. It exports the same functions (with the same C++ decorated names) as ScriptHookV,
+// but script functions only run the handlers registered with `stubRegisterNative` and everything else does nothing.
+
+#include <Windows.h>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+enum eGameVersion : int
+{
+    VER_STUB_LATEST = 0x7FFFFFFE,
+};
+
+typedef void(*KeyboardHandler)(DWORD, WORD, BYTE, BOOL, BOOL, BOOL, BOOL);
+typedef void(*PresentCallback)(void *);
+typedef void(*StubNativeHandler)(const UINT64 *args, int argCount, UINT64 *result);
+
+static const int sMaxArgCount = 32;
+static const int sResultSize = 3;
+
+// Script functions are only called from one thread at a time, just like in the game
+static thread_local UINT64 sCurrentHash;
+static thread_local UINT64 sArgs[sMaxArgCount];
+static thread_local int sArgCount;
+static thread_local UINT64 sResult[sResultSize];
+
+static std::mutex sNativeTableMutex;
+static std::unordered_map<UINT64, StubNativeHandler> sNativeTable;
+static int sGameVersion = VER_STUB_LATEST;
+static UINT64 sGlobals[0x40000];
+
+#define STUB_EXPORT __declspec(dllexport)
+
+/* Script functions */
+
+STUB_EXPORT void nativeInit(UINT64 hash)
+{
+    sCurrentHash = hash;
+    sArgCount = 0;
+}
+
+STUB_EXPORT void nativePush64(UINT64 val)
+{
+    if (sArgCount < sMaxArgCount)
+    {
+        sArgs[sArgCount++] = val;
+    }
+}
+
+STUB_EXPORT PUINT64 nativeCall()
+{
+    std::memset(sResult, 0, sizeof(sResult));
+
+    StubNativeHandler handler = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(sNativeTableMutex);
+        auto it = sNativeTable.find(sCurrentHash);
+        if (it != sNativeTable.end())
+        {
+            handler = it->second;
+        }
+    }
+
+    if (handler != nullptr)
+    {
+        handler(sArgs, sArgCount, sResult);
+    }
+
+    return sResult;
+}
+
+/* Scripts, keyboard and present callbacks (never called back, since there is no game loop) */
+
+STUB_EXPORT void scriptWait(DWORD time) { Sleep(time); }
+STUB_EXPORT void scriptRegister(HMODULE module, void(*LP_SCRIPT_MAIN)()) { }
+STUB_EXPORT void scriptRegisterAdditionalThread(HMODULE module, void(*LP_SCRIPT_MAIN)()) { }
+STUB_EXPORT void scriptUnregister(HMODULE module) { }
+STUB_EXPORT void scriptUnregister(void(*LP_SCRIPT_MAIN)()) { }
+STUB_EXPORT void keyboardHandlerRegister(KeyboardHandler handler) { }
+STUB_EXPORT void keyboardHandlerUnregister(KeyboardHandler handler) { }
+STUB_EXPORT void presentCallbackRegister(PresentCallback cb) { }
+STUB_EXPORT void presentCallbackUnregister(PresentCallback cb) { }
+
+/* Textures */
+
+STUB_EXPORT int createTexture(const char *texFileName) { return 0; }
+STUB_EXPORT void drawTexture(int id, int index, int level, int time,
+    float sizeX, float sizeY, float centerX, float centerY,
+    float posX, float posY, float rotation, float screenHeightScaleFactor,
+    float r, float g, float b, float a) { }
+
+/* Game state */
+
+STUB_EXPORT eGameVersion getGameVersion() { return static_cast<eGameVersion>(sGameVersion); }
+STUB_EXPORT UINT64 *getGlobalPtr(int globalId) { return &sGlobals[globalId & (ARRAYSIZE(sGlobals) - 1)]; }
+STUB_EXPORT BYTE *getScriptHandleBaseAddress(int handle) { return nullptr; }
+STUB_EXPORT int worldGetAllVehicles(int *arr, int arrSize) { return 0; }
+STUB_EXPORT int worldGetAllPeds(int *arr, int arrSize) { return 0; }
+STUB_EXPORT int worldGetAllObjects(int *arr, int arrSize) { return 0; }
+STUB_EXPORT int worldGetAllPickups(int *arr, int arrSize) { return 0; }
+
+/* Configuration for the benchmarks (not part of ScriptHookV) */
+
+/// Registers the handler that is called when the script function with the hash is called.
+/// Script functions without a handler return zero.
+extern "C" STUB_EXPORT void stubRegisterNative(UINT64 hash, StubNativeHandler handler)
+{
+    std::lock_guard<std::mutex> lock(sNativeTableMutex);
+    if (handler != nullptr)
+    {
+        sNativeTable[hash] = handler;
+    }
+    else
+    {
+        sNativeTable.erase(hash);
+    }
+}
+
+/// Sets the value `getGameVersion` returns.
+extern "C" STUB_EXPORT void stubSetGameVersion(int version)
+{
+    sGameVersion = version;
+}
@@ -0,0 +1,87 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using BenchmarkDotNet.Attributes;
+using SHVDN;
+using System;
+using System.Diagnostics;
+
+namespace ScriptHookVDotNet_Benchmarks
+{
+    /// <summary>
+    /// Measures what one frame costs with N scripts whose tick handlers do nothing, which is the overhead the script
+    /// domain adds on top of the scripts themselves.
+    /// </summary>
+    /// <remarks>
+    /// Each frame runs the script part of <c>ScriptDomain.DoTick</c>: the timeout stopwatch, the metrics, and either
+    /// the tick on the main thread or the hand-off to the script thread and back.
+    /// </remarks>
+    public class ScriptTickBenchmarks
+    {
+        private Script[] _scripts;
+
+        [Params(1, 16, 64)]
+        public int ScriptCount { get; set; }
+
+        [Params(false, true)]
+        public bool UseThread { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _scripts = new Script[ScriptCount];
+            for (int i = 0; i < _scripts.Length; i++)
+            {
+                var script = new Script { Name = "Benchmark" + i };
+                script.Tick += OnTick;
+                script.Start(UseThread);
+                _scripts[i] = script;
+            }
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            foreach (Script script in _scripts)
+            {
+                script.Abort();
+                script.Dispose();
+            }
+        }
+
+        [Benchmark]
+        public void Frame()
+        {
+            foreach (Script script in _scripts)
+            {
+                script.StopwatchForTimeout.Restart();
+                long tickStartTimestamp = Stopwatch.GetTimestamp();
+                if (script.IsUsingThread)
+                {
+                    script.ContinueEvent.Release();
+                    script.WaitEvent.Wait();
+                }
+                else
+                {
+                    script.Metrics.BeginSlice();
+                    try
+                    {
+                        script.DoTick();
+                    }
+                    finally
+                    {
+                        script.Metrics.EndSlice();
+                    }
+                }
+                script.StopwatchForTimeout.Stop();
+                script.Metrics.CompleteTick(Stopwatch.GetTimestamp() - tickStartTimestamp);
+            }
+        }
+
+        private static void OnTick(object sender, EventArgs e)
+        {
+        }
+    }
+}
@@ -0,0 +1,49 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using BenchmarkDotNet.Attributes;
+using System;
+using System.Runtime.InteropServices;
+
+namespace ScriptHookVDotNet_Benchmarks
+{
+    /// <summary>
+    /// Measures the UTF-8 conversions every script function call with a string argument or result goes through.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class StringMarshalBenchmarks
+    {
+        private string _string;
+        private IntPtr _utf8String;
+
+        [Params(16, 256)]
+        public int Length { get; set; }
+
+        [Params(false, true)]
+        public bool NonAscii { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _string = new string(NonAscii ? 'ä' : 'a', Length);
+            _utf8String = SHVDN.StringMarshal.StringToCoTaskMemUtf8(_string);
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            Marshal.FreeCoTaskMem(_utf8String);
+        }
+
+        [Benchmark]
+        public void StringToCoTaskMemUtf8()
+        {
+            Marshal.FreeCoTaskMem(SHVDN.StringMarshal.StringToCoTaskMemUtf8(_string));
+        }
+
+        [Benchmark]
+        public string PtrToStringUtf8() => SHVDN.StringMarshal.PtrToStringUtf8(_utf8String);
+    }
+}
@@ -0,0 +1,92 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// A set of blip sprite indices stored as a bitset, so testing a blip against it is a single bit lookup.
+    /// </summary>
+    /// <remarks>
+    /// The bitset only covers the indices up to <see cref="MaxBitsetSpriteType"/>, so one large index does not allocate
+    /// a large array. The indices outside of it are kept in a plain array, which is searched linearly.
+    /// </remarks>
+    public sealed class BlipSpriteMask
+    {
+        /// <summary>
+        /// The largest sprite index stored in the bitset, which keeps it at 512 bytes or less. The game has fewer than
+        /// 1000 sprites.
+        /// </summary>
+        public const int MaxBitsetSpriteType = 4095;
+
+        private readonly ulong[] _bits;
+        private readonly int[] _outOfRangeSpriteTypes;
+
+        /// <summary>
+        /// A mask that matches every sprite.
+        /// </summary>
+        public static readonly BlipSpriteMask All = new(Array.Empty<int>());
+
+        /// <param name="spriteTypes">The sprite indices to match. An empty array matches every sprite.</param>
+        public BlipSpriteMask(int[] spriteTypes)
+        {
+            if (spriteTypes == null)
+            {
+                throw new ArgumentNullException(nameof(spriteTypes));
+            }
+
+            int maxSpriteType = -1;
+            int outOfRangeCount = 0;
+            foreach (int spriteType in spriteTypes)
+            {
+                if ((uint)spriteType > MaxBitsetSpriteType)
+                {
+                    outOfRangeCount++;
+                    continue;
+                }
+
+                maxSpriteType = Math.Max(maxSpriteType, spriteType);
+            }
+
+            _bits = new ulong[(maxSpriteType >> 6) + 1];
+            _outOfRangeSpriteTypes = outOfRangeCount != 0 ? new int[outOfRangeCount] : Array.Empty<int>();
+            outOfRangeCount = 0;
+            foreach (int spriteType in spriteTypes)
+            {
+                if ((uint)spriteType > MaxBitsetSpriteType)
+                {
+                    _outOfRangeSpriteTypes[outOfRangeCount++] = spriteType;
+                    continue;
+                }
+
+                _bits[spriteType >> 6] |= 1ul << (spriteType & 63);
+            }
+
+            MatchesAll = spriteTypes.Length == 0;
+        }
+
+        /// <summary>
+        /// Gets whether this mask was created without sprite indices and matches every sprite.
+        /// </summary>
+        public bool MatchesAll { get; }
+
+        public bool Contains(int spriteType)
+        {
+            if (MatchesAll)
+            {
+                return true;
+            }
+
+            if ((uint)spriteType > MaxBitsetSpriteType)
+            {
+                return Array.IndexOf(_outOfRangeSpriteTypes, spriteType) >= 0;
+            }
+
+            int word = spriteType >> 6;
+            return word < _bits.Length && (_bits[word] & (1ul << (spriteType & 63))) != 0;
+        }
+    }
+}
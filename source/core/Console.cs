@@ -5,7 +5,6 @@
 
 using System;
 using System.CodeDom.Compiler;
-using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Drawing;
 using System.Linq;
@@ -24,9 +23,23 @@ namespace SHVDN
         private int _currentPage = 1;
         private bool _isOpen = false;
         private string _input = string.Empty;
-        private List<string> _lineHistory = new();
+        private List<ConsoleLine> _lineHistory = new();
+        private List<string> _unwrappedLines = new(); // Drained from the output buffer but not wrapped to the console width yet
+        private int _firstUnwrappedLineRowIndex; // The row the first unwrapped line continues at if wrapping it ran out of budget
         private List<string> _commandHistory; // This must be set via CommandHistory property
-        private ConcurrentQueue<string[]> _outputQueue = new();
+        private readonly ConsoleOutputBuffer _outputBuffer = new(MaxPendingLines, MaxLinesPerSourcePerSecond);
+        private readonly NativeCallBatch _drawBatch = new(64, 512);
+        private readonly NativeCallBatch _measureBatch = new(8, 32);
+        private int _pinnedLineStart;
+        private int _pinnedLineEnd;
+        private ConsoleLine _inputLine;
+        private ConsoleLine _pageInfoLine;
+        private int _pageInfoCurrentPage;
+        private int _pageInfoPageCount;
+        private float _marginLength = float.NaN;
+        private float _cursorOffset;
+        private string _cursorOffsetInput;
+        private int _cursorOffsetPos = -1;
         private Dictionary<string, List<ConsoleCommand>> _commands = new();
         private int _lastClosedTickCount;
         private bool _shouldBlockControls;
@@ -42,6 +55,22 @@ namespace SHVDN
         private const int ConsoleHeight = BaseHeight / 3;
         private const int InputHeight = 20;
         private const int LinesPerPage = 16;
+        private const int MaxPendingLines = 2048;
+        private const int MaxLinesPerSourcePerSecond = 200;
+        private const int MaxWrappedRowsPerLine = 32;
+        private const int MaxHistoryLines = 4096;
+        // The number of text measurements spent on wrapping new lines per tick, so a burst of output is wrapped over
+        // several frames instead of causing a hitch in one
+        private const int WrapMeasureBudgetPerTick = 48;
+        private const int MaxRowSplitAttempts = 8;
+        // A row is only started with enough budget left to finish it, which is one measurement of the whole row and
+        // one per split attempt
+        private const int MaxMeasurementsPerRow = 1 + MaxRowSplitAttempts;
+        private const string InfoPrefix = "[~b~INFO~w~] ";
+        private const string ErrorPrefix = "[~r~ERROR~w~] ";
+        private const string WarningPrefix = "[~o~WARNING~w~] ";
+
+        private static readonly ConsoleLine s_inputPrefixLine = new("$>");
 
         private static readonly Color s_inputColor = Color.White;
         private static readonly Color s_inputColorBusy = Color.DarkGray;
@@ -76,6 +105,9 @@ namespace SHVDN
                     _isOpen = value;
                     if (_isOpen)
                     {
+                        // The measured widths depend on the screen resolution, which may have changed while the console was closed
+                        _marginLength = float.NaN;
+                        _cursorOffsetPos = -1;
                         return;
                     }
 
@@ -190,12 +222,35 @@ namespace SHVDN
         /// <param name="color">The color of those lines.</param>
         private void AddLines(string prefix, string[] messages, string color)
         {
+            string time = DateTime.Now.ToString("HH:mm:ss");
             for (int i = 0; i < messages.Length; i++) // Add proper styling
             {
-                messages[i] = $"~c~[{DateTime.Now.ToString("HH:mm:ss")}] ~w~{prefix} {color}{messages[i]}";
+                messages[i] = $"~c~[{time}] ~w~{prefix} {color}{messages[i]}";
             }
 
-            _outputQueue.Enqueue(messages);
+            // Lines written by SHVDN itself outside of script ticks are never rate limited
+            _outputBuffer.Add(ScriptDomain.ExecutingScript?.Name, messages);
+        }
+        /// <summary>
+        /// Formats a single message line the same way the print methods do.
+        /// </summary>
+        /// <param name="level">The level that decides the prefix of the line.</param>
+        /// <param name="message">The message without line breaks.</param>
+        internal static string FormatLine(Log.Level level, string message)
+        {
+            return $"~c~[{DateTime.Now.ToString("HH:mm:ss")}] ~w~{GetPrefix(level)} ~w~{message}";
+        }
+        private static string GetPrefix(Log.Level level)
+        {
+            switch (level)
+            {
+                case Log.Level.Error:
+                    return ErrorPrefix;
+                case Log.Level.Warning:
+                    return WarningPrefix;
+                default:
+                    return InfoPrefix;
+            }
         }
         /// <summary>
         /// Add text to the console input line.
@@ -243,7 +298,10 @@ namespace SHVDN
         {
             lock (_lock)
             {
+                ReleasePinnedLines(0, 0);
                 _lineHistory.Clear();
+                _unwrappedLines.Clear();
+                _firstUnwrappedLineRowIndex = 0;
                 _currentPage = 1;
             }
         }
@@ -254,7 +312,7 @@ namespace SHVDN
         /// <param name="msg">The composite format string.</param>
         public void PrintInfo(string msg)
         {
-            AddLines("[~b~INFO~w~] ", msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
+            AddLines(InfoPrefix, msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
         }
         /// <summary>
         /// Writes an info message to the console.
@@ -268,7 +326,7 @@ namespace SHVDN
                 msg = String.Format(msg, args);
             }
 
-            AddLines("[~b~INFO~w~] ", msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
+            AddLines(InfoPrefix, msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
         }
         /// <summary>
         /// Writes an error message to the console.
@@ -276,7 +334,7 @@ namespace SHVDN
         /// <param name="msg">The composite format string.</param>
         public void PrintError(string msg)
         {
-            AddLines("[~r~ERROR~w~] ", msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
+            AddLines(ErrorPrefix, msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
         }
         /// <summary>
         /// Writes an error message to the console.
@@ -290,7 +348,7 @@ namespace SHVDN
                 msg = String.Format(msg, args);
             }
 
-            AddLines("[~r~ERROR~w~] ", msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
+            AddLines(ErrorPrefix, msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
         }
         /// <summary>
         /// Writes a warning message to the console.
@@ -298,7 +356,7 @@ namespace SHVDN
         /// <param name="msg">The composite format string.</param>
         public void PrintWarning(string msg)
         {
-            AddLines("[~o~WARNING~w~] ", msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
+            AddLines(WarningPrefix, msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
         }
         /// <summary>
         /// Writes a warning message to the console.
@@ -312,7 +370,43 @@ namespace SHVDN
                 msg = String.Format(msg, args);
             }
 
-            AddLines("[~o~WARNING~w~] ", msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
+            AddLines(WarningPrefix, msg.Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries));
+        }
+
+        /// <summary>
+        /// Writes multiple messages to the console at once.
+        /// Prefer this over calling the print methods in a loop from another <see cref="AppDomain"/>,
+        /// since every call on the console from there is a remoting call.
+        /// </summary>
+        /// <param name="levels">The level of each message. <see cref="Log.Level.Info"/> and <see cref="Log.Level.Debug"/> are printed as info messages.</param>
+        /// <param name="messages">The messages to write.</param>
+        public void PrintMessages(Log.Level[] levels, string[] messages)
+        {
+            if (levels == null)
+            {
+                throw new ArgumentNullException(nameof(levels));
+            }
+            if (messages == null)
+            {
+                throw new ArgumentNullException(nameof(messages));
+            }
+            if (levels.Length != messages.Length)
+            {
+                throw new ArgumentException("The number of levels must match the number of messages.", nameof(levels));
+            }
+
+            var lines = new List<string>(messages.Length);
+            string time = DateTime.Now.ToString("HH:mm:ss");
+            for (int i = 0; i < messages.Length; i++)
+            {
+                string prefix = GetPrefix(levels[i]);
+                foreach (string line in messages[i].Split(new[] { '\n' }, StringSplitOptions.RemoveEmptyEntries))
+                {
+                    lines.Add($"~c~[{time}] ~w~{prefix} ~w~{line}");
+                }
+            }
+
+            _outputBuffer.Add(ScriptDomain.ExecutingScript?.Name, lines.ToArray());
         }
 
         /// <summary>
@@ -418,15 +512,16 @@ namespace SHVDN
                 compilerTask = null;
             }
 
-            // Add lines from concurrent queue to history
-            if (_outputQueue.TryDequeue(out string[] lines))
+            // Move all the lines written since the last tick out of the output buffer at once
+            lock (_lock)
             {
-                lock (_lock)
+                _outputBuffer.Drain(_unwrappedLines);
+
+                // Lines older than the retained history would be dropped right after wrapping them anyway
+                if (_unwrappedLines.Count > MaxHistoryLines)
                 {
-                    foreach (string line in lines)
-                    {
-                        _lineHistory.Add(line);
-                    }
+                    _unwrappedLines.RemoveRange(0, _unwrappedLines.Count - MaxHistoryLines);
+                    _firstUnwrappedLineRowIndex = 0;
                 }
             }
 
@@ -438,6 +533,9 @@ namespace SHVDN
                 {
                     lastClosedTickCount = _lastClosedTickCount;
                     shouldBlockControls = _shouldBlockControls;
+
+                    // Nothing is drawn until the console opens again, so do not keep the text of the last page pinned
+                    ReleasePinnedLines(0, 0);
                 }
                 // Hack so the input gets blocked long enough
                 if ((lastClosedTickCount - nowTickCount) > 0)
@@ -458,45 +556,290 @@ namespace SHVDN
             // Disable controls while the console is open
             DisableControlsThisFrame();
 
-            string currInput = null;
-            int currLineHistCount = 0;
-            int currPage = 0;
+            NativeCallBatch batch = _drawBatch;
+            batch.Clear();
+
             lock (_lock)
             {
-                currInput = _input;
-                currLineHistCount = _lineHistory.Count;
-                currPage = _currentPage;
-            }
+                // Only wrap while the console is open, since nothing measures or draws text while it is closed
+                WrapPendingLines(WrapMeasureBudgetPerTick);
 
-            // Draw background
-            DrawRect(0, 0, ConsoleWidth, ConsoleHeight, s_backgroundColor);
-            // Draw input field
-            DrawRect(0, ConsoleHeight, ConsoleWidth, InputHeight, s_altBackgroundColor);
-            DrawRect(0, ConsoleHeight + InputHeight, 80, InputHeight, s_altBackgroundColor);
-            // Draw input prefix
-            DrawText(0, ConsoleHeight, "$>", s_prefixColor);
-            // Draw input text
-            DrawText(25, ConsoleHeight, currInput, compilerTask == null ? s_inputColor : s_inputColorBusy);
-            // Draw page information
-            DrawText(5, ConsoleHeight + InputHeight, "Page " + currPage + "/" + System.Math.Max(1, ((currLineHistCount + (LinesPerPage - 1)) / LinesPerPage)), s_inputColor);
+                int currLineHistCount = _lineHistory.Count;
+                int currPage = _currentPage;
+                int pageCount = System.Math.Max(1, ((currLineHistCount + (LinesPerPage - 1)) / LinesPerPage));
+
+                if (!ReferenceEquals(_inputLine?.Text, _input))
+                {
+                    _inputLine?.ReleaseChunks();
+                    _inputLine = new ConsoleLine(_input);
+                }
+                if (_pageInfoLine == null || _pageInfoCurrentPage != currPage || _pageInfoPageCount != pageCount)
+                {
+                    _pageInfoLine?.ReleaseChunks();
+                    _pageInfoLine = new ConsoleLine("Page " + currPage + "/" + pageCount);
+                    _pageInfoCurrentPage = currPage;
+                    _pageInfoPageCount = pageCount;
+                }
+
+                // Draw background
+                PushRect(batch, 0, 0, ConsoleWidth, ConsoleHeight, s_backgroundColor);
+                // Draw input field
+                PushRect(batch, 0, ConsoleHeight, ConsoleWidth, InputHeight, s_altBackgroundColor);
+                PushRect(batch, 0, ConsoleHeight + InputHeight, 80, InputHeight, s_altBackgroundColor);
+                // Draw input prefix
+                PushText(batch, 0, ConsoleHeight, s_inputPrefixLine, s_prefixColor);
+                // Draw input text
+                PushText(batch, 25, ConsoleHeight, _inputLine, compilerTask == null ? s_inputColor : s_inputColorBusy);
+                // Draw page information
+                PushText(batch, 5, ConsoleHeight + InputHeight, _pageInfoLine, s_inputColor);
 
-            lock (_lock)
-            {
                 // Draw blinking cursor
                 if (nowTickCount % 1000 < 500)
                 {
-                    float lengthBetweenInputStartAndCursor = GetTextLength(currInput.Substring(0, _cursorPos)) - GetMarginLength();
-                    DrawRect(26 + (lengthBetweenInputStartAndCursor * ConsoleWidth), ConsoleHeight + 2, 2, InputHeight - 4, Color.White);
+                    if (!ReferenceEquals(_cursorOffsetInput, _input) || _cursorOffsetPos != _cursorPos)
+                    {
+                        _cursorOffset = MeasureText(_input.Substring(0, _cursorPos)) - _marginLength;
+                        _cursorOffsetInput = _input;
+                        _cursorOffsetPos = _cursorPos;
+                    }
+
+                    PushRect(batch, 26 + (_cursorOffset * ConsoleWidth), ConsoleHeight + 2, 2, InputHeight - 4, Color.White);
                 }
 
                 // Draw console history text
                 int historyOffset = currLineHistCount - (LinesPerPage * currPage);
                 int historyLength = historyOffset + LinesPerPage;
-                for (int i = System.Math.Max(0, historyOffset); i < historyLength; ++i)
+                int historyStart = System.Math.Max(0, historyOffset);
+                for (int i = historyStart; i < historyLength; ++i)
+                {
+                    PushText(batch, 2, (float)((i - historyOffset) * 14), _lineHistory[i], s_outputColor);
+                }
+                ReleasePinnedLines(historyStart, System.Math.Max(historyStart, historyLength));
+
+                unsafe
+                {
+                    NativeFunc.InvokeBatch(batch);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Wraps the oldest lines drained from the output buffer to the console width and appends them to the history,
+        /// measuring at most <paramref name="measureBudget"/> texts. Lines are wrapped once instead of every frame they
+        /// are visible, and a long line that runs out of budget continues at the same row in the next call. Must be
+        /// called with <see cref="_lock"/> held.
+        /// </summary>
+        private void WrapPendingLines(int measureBudget)
+        {
+            if (_unwrappedLines.Count == 0)
+            {
+                return;
+            }
+
+            if (float.IsNaN(_marginLength))
+            {
+                _marginLength = GetMarginLength();
+                measureBudget -= 2;
+            }
+
+            const float MaxRowWidth = (float)(ConsoleWidth - 4) / BaseWidth;
+
+            int wrappedLineCount = 0;
+            int pausedRowIndex = 0;
+            while (wrappedLineCount < _unwrappedLines.Count)
+            {
+                string rowText = _unwrappedLines[wrappedLineCount];
+                int rowIndex = wrappedLineCount == 0 ? _firstUnwrappedLineRowIndex : 0;
+                bool isLineWrapped = false;
+                for (; measureBudget >= MaxMeasurementsPerRow; rowIndex++)
+                {
+                    measureBudget--;
+                    float rowWidth = MeasureText(rowText) - _marginLength;
+                    if (rowWidth <= MaxRowWidth || rowIndex == MaxWrappedRowsPerLine - 1)
+                    {
+                        _lineHistory.Add(new ConsoleLine(rowText));
+                        isLineWrapped = true;
+                        break;
+                    }
+
+                    // The continuation row starts with the color and boldness active at the split position,
+                    // since the game resets the text formatting for every text it draws
+                    int prefixLength = rowIndex == 0 ? 0 : ParseFormatting(rowText, rowText.Length, out _, out _, out _);
+                    int splitPos = FindRowSplitPosition(rowText, prefixLength, rowWidth, MaxRowWidth, ref measureBudget);
+                    if (splitPos <= prefixLength || splitPos >= rowText.Length)
+                    {
+                        _lineHistory.Add(new ConsoleLine(rowText));
+                        isLineWrapped = true;
+                        break;
+                    }
+
+                    ParseFormatting(rowText, splitPos, out string colorToken, out bool isBold, out int safeSplitPos);
+                    if (safeSplitPos > prefixLength)
+                    {
+                        splitPos = safeSplitPos;
+                    }
+                    _lineHistory.Add(new ConsoleLine(rowText.Substring(0, splitPos)));
+
+                    string continuation = rowText.Substring(splitPos).TrimStart(' ');
+                    if (continuation.Length == 0)
+                    {
+                        isLineWrapped = true;
+                        break;
+                    }
+
+                    rowText = colorToken + (isBold ? "~h~" : string.Empty) + continuation;
+                }
+
+                if (!isLineWrapped)
+                {
+                    // Out of budget, keep the rest of the line for the next call
+                    _unwrappedLines[wrappedLineCount] = rowText;
+                    pausedRowIndex = rowIndex;
+                    break;
+                }
+
+                wrappedLineCount++;
+            }
+
+            _unwrappedLines.RemoveRange(0, wrappedLineCount);
+            _firstUnwrappedLineRowIndex = pausedRowIndex;
+
+            TrimLineHistory();
+        }
+        /// <summary>
+        /// Drops the oldest lines once the history grows past <see cref="MaxHistoryLines"/> by a few pages, so the list
+        /// is not shifted on every new line. Must be called with <see cref="_lock"/> held.
+        /// </summary>
+        private void TrimLineHistory()
+        {
+            int excess = _lineHistory.Count - MaxHistoryLines;
+            if (excess < LinesPerPage * 4)
+            {
+                return;
+            }
+
+            // The pinned range is stored as indices, which the removal shifts
+            ReleasePinnedLines(0, 0);
+            for (int i = 0; i < excess; i++)
+            {
+                _lineHistory[i].ReleaseChunks();
+            }
+            _lineHistory.RemoveRange(0, excess);
+
+            int pageCount = System.Math.Max(1, (_lineHistory.Count + (LinesPerPage - 1)) / LinesPerPage);
+            _currentPage = System.Math.Min(_currentPage, pageCount);
+        }
+        /// <summary>
+        /// Finds the position to split <paramref name="rowText"/> at so that the first part fits in <paramref name="maxWidth"/>,
+        /// preferring a word boundary. Each measurement is taken from <paramref name="measureBudget"/>.
+        /// </summary>
+        private int FindRowSplitPosition(string rowText, int prefixLength, float rowWidth, float maxWidth, ref int measureBudget)
+        {
+            int splitPos = rowText.Length;
+            float splitWidth = rowWidth;
+
+            // The width is not linear in the character count, so shrink proportionally until the row fits
+            for (int attempt = 0; attempt < MaxRowSplitAttempts && splitWidth > maxWidth; attempt++)
+            {
+                int candidate = prefixLength + (int)((splitPos - prefixLength) * (maxWidth / splitWidth));
+                candidate = System.Math.Max(prefixLength + 1, System.Math.Min(candidate, splitPos - 1));
+
+                int wordBreak = rowText.LastIndexOf(' ', candidate - 1, candidate - prefixLength);
+                if (wordBreak > prefixLength + (candidate - prefixLength) / 2)
+                {
+                    candidate = wordBreak + 1;
+                }
+
+                if (candidate == splitPos)
+                {
+                    break;
+                }
+
+                splitPos = candidate;
+                measureBudget--;
+                splitWidth = MeasureText(rowText.Substring(0, splitPos)) - _marginLength;
+            }
+
+            return splitPos;
+        }
+        /// <summary>
+        /// Scans the formatting tokens (e.g. <c>~r~</c> or <c>~h~</c>) of <paramref name="text"/> before <paramref name="end"/>.
+        /// </summary>
+        /// <param name="text">The text to scan.</param>
+        /// <param name="end">The position to stop scanning at.</param>
+        /// <param name="colorToken">The last color token before <paramref name="end"/>, or an empty string if there is none.</param>
+        /// <param name="isBold">Whether the text at <paramref name="end"/> is drawn bold.</param>
+        /// <param name="safeEnd"><paramref name="end"/>, or the start of the token <paramref name="end"/> lies in.</param>
+        /// <returns>The length of the leading run of formatting tokens of <paramref name="text"/>.</returns>
+        private static int ParseFormatting(string text, int end, out string colorToken, out bool isBold, out int safeEnd)
+        {
+            colorToken = string.Empty;
+            isBold = false;
+            safeEnd = end;
+
+            int leadingTokenLength = 0;
+            bool isLeading = true;
+            int pos = 0;
+            while (pos < end)
+            {
+                int tokenEnd = text[pos] == '~' ? text.IndexOf('~', pos + 1) : -1;
+                if (tokenEnd < 0)
+                {
+                    isLeading = false;
+                    pos++;
+                    continue;
+                }
+
+                if (tokenEnd >= end)
+                {
+                    // Never split a token in half
+                    safeEnd = pos;
+                    break;
+                }
+
+                int tokenLength = tokenEnd - pos - 1;
+                char tokenChar = text[pos + 1];
+                if (tokenLength == 1 && tokenChar == 'h')
+                {
+                    isBold = true;
+                }
+                else if (tokenLength == 1 && tokenChar == 's')
                 {
-                    DrawText(2, (float)((i - historyOffset) * 14), _lineHistory[i], s_outputColor);
+                    colorToken = string.Empty;
+                    isBold = false;
+                }
+                else if ((tokenLength == 1 && char.IsLower(tokenChar) && tokenChar != 'n')
+                    || (tokenLength > 11 && string.CompareOrdinal(text, pos + 1, "HUD_COLOUR_", 0, 11) == 0))
+                {
+                    colorToken = text.Substring(pos, tokenLength + 2);
+                }
+
+                pos = tokenEnd + 1;
+                if (isLeading)
+                {
+                    leadingTokenLength = pos;
+                }
+            }
+
+            return leadingTokenLength;
+        }
+        /// <summary>
+        /// Frees the pinned text of the history lines outside of the range that is visible this frame.
+        /// Must be called with <see cref="_lock"/> held.
+        /// </summary>
+        private void ReleasePinnedLines(int visibleStart, int visibleEnd)
+        {
+            int historyCount = _lineHistory.Count;
+            for (int i = _pinnedLineStart; i < _pinnedLineEnd && i < historyCount; i++)
+            {
+                if (i < visibleStart || i >= visibleEnd)
+                {
+                    _lineHistory[i].ReleaseChunks();
                 }
             }
+
+            _pinnedLineStart = visibleStart;
+            _pinnedLineEnd = visibleEnd;
         }
         /// <summary>
         /// Keyboard handling logic of the console.
@@ -1317,26 +1660,44 @@ namespace SHVDN
             return null;
         }
 
-        private static unsafe void DrawRect(float x, float y, int width, int height, Color color)
+        private static void PushRect(NativeCallBatch batch, float x, float y, int width, int height, Color color)
         {
             float w = (float)(width) / BaseWidth;
             float h = (float)(height) / BaseHeight;
 
-            NativeFunc.Invoke(0x3A618A217E5154F0ul /* DRAW_RECT */,
-                (x / BaseWidth) + w * 0.5f,
-                (y / BaseHeight) + h * 0.5f,
-                w, h,
-                color.R, color.G, color.B, color.A);
+            batch.BeginCall(0x3A618A217E5154F0ul /* DRAW_RECT */);
+            batch.PushArgument((x / BaseWidth) + w * 0.5f);
+            batch.PushArgument((y / BaseHeight) + h * 0.5f);
+            batch.PushArgument(w);
+            batch.PushArgument(h);
+            batch.PushArgument(color.R);
+            batch.PushArgument(color.G);
+            batch.PushArgument(color.B);
+            batch.PushArgument(color.A);
         }
 
-        private static unsafe void DrawText(float x, float y, string text, Color color)
+        private static void PushText(NativeCallBatch batch, float x, float y, ConsoleLine line, Color color)
         {
-            NativeFunc.Invoke(0x66E0276CC5F6B9DA /* SET_TEXT_FONT */, 0); // Chalet London :>
-            NativeFunc.Invoke(0x07C837F9A01C34C9 /* SET_TEXT_SCALE */, 0.35f, 0.35f);
-            NativeFunc.Invoke(0xBE6B23FFA53FB442 /* SET_TEXT_COLOUR */, color.R, color.G, color.B, color.A);
-            NativeFunc.Invoke(0x25FBB336DF1804CB /* BEGIN_TEXT_COMMAND_DISPLAY_TEXT */, NativeMemory.CellEmailBcon);
-            NativeFunc.PushLongString(text, 99);
-            NativeFunc.Invoke(0xCD015E5BB0D96A57 /* END_TEXT_COMMAND_DISPLAY_TEXT */, (x / BaseWidth), (y / BaseHeight));
+            batch.BeginCall(0x66E0276CC5F6B9DA /* SET_TEXT_FONT */);
+            batch.PushArgument(0); // Chalet London :>
+            batch.BeginCall(0x07C837F9A01C34C9 /* SET_TEXT_SCALE */);
+            batch.PushArgument(0.35f);
+            batch.PushArgument(0.35f);
+            batch.BeginCall(0xBE6B23FFA53FB442 /* SET_TEXT_COLOUR */);
+            batch.PushArgument(color.R);
+            batch.PushArgument(color.G);
+            batch.PushArgument(color.B);
+            batch.PushArgument(color.A);
+            batch.BeginCall(0x25FBB336DF1804CB /* BEGIN_TEXT_COMMAND_DISPLAY_TEXT */);
+            batch.PushArgument(NativeMemory.CellEmailBcon);
+            foreach (IntPtr chunk in line.GetChunks())
+            {
+                batch.BeginCall(0x6C188BE134E074AA /* ADD_TEXT_COMPONENT_SUBSTRING_PLAYER_NAME */);
+                batch.PushArgument(chunk);
+            }
+            batch.BeginCall(0xCD015E5BB0D96A57 /* END_TEXT_COMMAND_DISPLAY_TEXT */);
+            batch.PushArgument(x / BaseWidth);
+            batch.PushArgument(y / BaseHeight);
         }
 
         private static unsafe void DisableControlsThisFrame()
@@ -1350,21 +1711,91 @@ namespace SHVDN
             }
         }
 
-        private static unsafe float GetTextLength(string text)
+        private unsafe float MeasureText(string text)
         {
-            NativeFunc.Invoke(0x66E0276CC5F6B9DA /* SET_TEXT_FONT */, 0);
-            NativeFunc.Invoke(0x07C837F9A01C34C9 /* SET_TEXT_SCALE */, 0.35f, 0.35f);
-            NativeFunc.Invoke(0x54CE8AC98E120CAB /* BEGIN_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT */, NativeMemory.CellEmailBcon);
-            NativeFunc.PushLongString(text, 98); // 99 byte string chunks don't process properly in END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT
-            return *(float*)NativeFunc.Invoke(0x85F061DA64ED2F67 /* END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT */, true);
+            NativeCallBatch batch = _measureBatch;
+            batch.Clear();
+            batch.BeginCall(0x66E0276CC5F6B9DA /* SET_TEXT_FONT */);
+            batch.PushArgument(0);
+            batch.BeginCall(0x07C837F9A01C34C9 /* SET_TEXT_SCALE */);
+            batch.PushArgument(0.35f);
+            batch.PushArgument(0.35f);
+            batch.BeginCall(0x54CE8AC98E120CAB /* BEGIN_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT */);
+            batch.PushArgument(NativeMemory.CellEmailBcon);
+            // 99 byte string chunks don't process properly in END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT
+            NativeFunc.PushLongString(text, str =>
+            {
+                batch.BeginCall(0x6C188BE134E074AA /* ADD_TEXT_COMPONENT_SUBSTRING_PLAYER_NAME */);
+                batch.PushArgument(ScriptDomain.CurrentDomain.PinString(str));
+            }, 98);
+            batch.BeginCall(0x85F061DA64ED2F67 /* END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT */);
+            batch.PushArgument(true);
+
+            return *(float*)NativeFunc.InvokeBatch(batch);
         }
 
-        private static float GetMarginLength()
+        private float GetMarginLength()
         {
-            float len1 = GetTextLength("A");
-            float len2 = GetTextLength("AA");
+            float len1 = MeasureText("A");
+            float len2 = MeasureText("AA");
             return len1 - (len2 - len1); // [Margin][A] - [A] = [Margin]
         }
+
+        /// <summary>
+        /// A line of the console with its text split up into text components and pinned to native memory while it is visible,
+        /// so drawing the same line every frame does not allocate.
+        /// </summary>
+        private sealed class ConsoleLine
+        {
+            private IntPtr[] _chunks;
+
+            internal ConsoleLine(string text)
+            {
+                Text = text;
+                // Most lines are never drawn, so only lines with pinned text need to be finalized
+                GC.SuppressFinalize(this);
+            }
+
+            ~ConsoleLine()
+            {
+                ReleaseChunks();
+            }
+
+            internal string Text { get; }
+
+            internal IntPtr[] GetChunks()
+            {
+                if (_chunks != null)
+                {
+                    return _chunks;
+                }
+
+                var chunks = new List<IntPtr>();
+                NativeFunc.PushLongString(Text, str =>
+                {
+                    chunks.Add(StringMarshal.StringToCoTaskMemUtf8(str));
+                });
+                _chunks = chunks.ToArray();
+                GC.ReRegisterForFinalize(this);
+                return _chunks;
+            }
+
+            internal void ReleaseChunks()
+            {
+                IntPtr[] chunks = _chunks;
+                if (chunks == null)
+                {
+                    return;
+                }
+
+                _chunks = null;
+                foreach (IntPtr handle in chunks)
+                {
+                    Marshal.FreeCoTaskMem(handle);
+                }
+                GC.SuppressFinalize(this);
+            }
+        }
     }
 
     public sealed class ConsoleCommand : Attribute
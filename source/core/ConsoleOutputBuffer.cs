@@ -0,0 +1,162 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// A bounded buffer for the output lines of the <see cref="Console"/>, which any thread can write to and which is
+    /// drained once per console tick.
+    /// </summary>
+    /// <remarks>
+    /// The lines each source (usually a script) can write are limited per second, so a chatty script cannot flood the
+    /// console. The number of suppressed lines is reported once the window of the source has passed.
+    /// When the buffer is full, the oldest pending lines are discarded and the count is reported on the next drain.
+    /// </remarks>
+    internal sealed class ConsoleOutputBuffer
+    {
+        private sealed class SourceState
+        {
+            internal int _windowStartTickCount;
+            internal int _lineCount;
+            internal int _suppressedCount;
+        }
+
+        private const int RateLimitWindowMilliseconds = 1000;
+
+        private readonly object _lock = new();
+        private readonly string[] _lines;
+        private readonly int _maxLinesPerSourcePerWindow;
+        private readonly Dictionary<string, SourceState> _sources = new(StringComparer.Ordinal);
+        private int _head;
+        private int _count;
+        private int _discardedCount;
+
+        internal ConsoleOutputBuffer(int capacity, int maxLinesPerSourcePerSecond)
+        {
+            _lines = new string[capacity];
+            _maxLinesPerSourcePerWindow = maxLinesPerSourcePerSecond;
+        }
+
+        /// <summary>
+        /// Adds lines written by <paramref name="source"/> to the buffer. This call is thread-safe.
+        /// </summary>
+        /// <param name="source">The name of the source to rate limit, or <see langword="null" /> to bypass rate limiting.</param>
+        /// <param name="lines">The lines to add.</param>
+        internal void Add(string source, string[] lines)
+        {
+            int nowTickCount = Environment.TickCount;
+
+            lock (_lock)
+            {
+                int allowedCount = lines.Length;
+                if (source != null)
+                {
+                    if (!_sources.TryGetValue(source, out SourceState state))
+                    {
+                        state = new SourceState { _windowStartTickCount = nowTickCount };
+                        _sources.Add(source, state);
+                    }
+
+                    CloseWindowIfElapsed(source, state, nowTickCount);
+
+                    allowedCount = Math.Min(lines.Length, Math.Max(0, _maxLinesPerSourcePerWindow - state._lineCount));
+                    state._lineCount += allowedCount;
+                    state._suppressedCount += lines.Length - allowedCount;
+                }
+
+                for (int i = 0; i < allowedCount; i++)
+                {
+                    Enqueue(lines[i]);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Moves all the pending lines to <paramref name="destination"/> in the order they were added.
+        /// </summary>
+        /// <returns>The number of lines moved.</returns>
+        internal int Drain(List<string> destination)
+        {
+            int nowTickCount = Environment.TickCount;
+
+            lock (_lock)
+            {
+                // Report sources that went quiet after being rate limited, since no new line would trigger it
+                List<string> idleSources = null;
+                foreach (KeyValuePair<string, SourceState> source in _sources)
+                {
+                    if ((nowTickCount - source.Value._windowStartTickCount) < RateLimitWindowMilliseconds)
+                    {
+                        continue;
+                    }
+
+                    CloseWindowIfElapsed(source.Key, source.Value, nowTickCount);
+                    (idleSources ??= new List<string>()).Add(source.Key);
+                }
+                if (idleSources != null)
+                {
+                    foreach (string source in idleSources)
+                    {
+                        _sources.Remove(source);
+                    }
+                }
+
+                int drainedCount = _count;
+                if (_discardedCount > 0)
+                {
+                    destination.Add(Console.FormatLine(Log.Level.Warning,
+                        $"Discarded {_discardedCount} console lines because the output buffer was full."));
+                    _discardedCount = 0;
+                    drainedCount++;
+                }
+
+                for (; _count > 0; _count--)
+                {
+                    destination.Add(_lines[_head]);
+                    _lines[_head] = null;
+                    _head = (_head + 1) % _lines.Length;
+                }
+
+                return drainedCount;
+            }
+        }
+
+        private void CloseWindowIfElapsed(string source, SourceState state, int nowTickCount)
+        {
+            if ((nowTickCount - state._windowStartTickCount) < RateLimitWindowMilliseconds)
+            {
+                return;
+            }
+
+            if (state._suppressedCount > 0)
+            {
+                Enqueue(Console.FormatLine(Log.Level.Warning,
+                    $"Suppressed {state._suppressedCount} console lines from \"{source}\" (limit is {_maxLinesPerSourcePerWindow} lines per second)."));
+            }
+
+            state._windowStartTickCount = nowTickCount;
+            state._lineCount = 0;
+            state._suppressedCount = 0;
+        }
+
+        private void Enqueue(string line)
+        {
+            if (_count == _lines.Length)
+            {
+                // Drop the oldest line rather than the newest, the latest output is the most relevant
+                _lines[_head] = null;
+                _head = (_head + 1) % _lines.Length;
+                _count--;
+                _discardedCount++;
+            }
+
+            _lines[(_head + _count) % _lines.Length] = line;
+            _count++;
+        }
+    }
+}
@@ -215,9 +215,39 @@ public:
             return;
         }
 
-        console->PrintInfo("~c~--- Loaded Scripts ---");
+        // Print all the lines at once, since the console lives in the script domain and every call is a remoting call
+        Text::StringBuilder^ output = gcnew Text::StringBuilder("~c~--- Loaded Scripts ---");
         for each (auto script in domain->RunningScripts)
-            console->PrintInfo(IO::Path::GetFileName(script->Filename) + " ~h~" + script->Name + (script->IsRunning ? (script->IsPaused ? " ~o~[paused]" : " ~g~[running]") : " ~r~[aborted]"));
+            output->Append('\n')->Append(IO::Path::GetFileName(script->Filename) + " ~h~" + script->Name + (script->IsRunning ? (script->IsPaused ? " ~o~[paused]" : " ~g~[running]") : " ~r~[aborted]"));
+        console->PrintInfo(output->ToString());
+    }
+
+    [SHVDN::ConsoleCommand("List the tick time, CPU time, allocations and native calls of all loaded scripts")]
+    static void ListScriptMetrics()
+    {
+        SHVDN::Console^ console = GetConsole();
+        if (console == nullptr)
+        {
+            WriteErrorMessageForConsoleNotLoadedWhenExecutingCommand("ListScriptMetrics");
+            return;
+        }
+
+        Text::StringBuilder^ output = gcnew Text::StringBuilder("~c~--- Script Metrics (tick last/avg/p99, averages of the last 256 ticks) ---");
+        for each (SHVDN::ScriptMetricsSnapshot^ metrics in domain->GetScriptMetrics())
+        {
+            output->Append('\n')->AppendFormat(
+                "{0} ~h~{1}~h~ ~w~tick {2:F2}/{3:F2}/{4:F2} ms, cpu {5:F2} ms, alloc {6:F1} KB, natives {7:F0}{8}",
+                IO::Path::GetFileName(metrics->Filename),
+                metrics->ScriptName,
+                metrics->LastTickTime.TotalMilliseconds,
+                metrics->AverageTickTime.TotalMilliseconds,
+                metrics->P99TickTime.TotalMilliseconds,
+                metrics->AverageCpuTime.TotalMilliseconds,
+                metrics->AverageAllocatedBytes / 1024.0,
+                metrics->AverageNativeCallCount,
+                metrics->ExceptionCount != 0 ? String::Format(", ~r~{0} exceptions", metrics->ExceptionCount) : String::Empty);
+        }
+        console->PrintInfo(output->ToString());
     }
 
 internal:
@@ -280,6 +310,9 @@ internal:
             return;
         }
 
+        // Send all the messages in one call, every call on the console is a remoting call into the script domain
+        List<SHVDN::Log::Level>^ levels = gcnew List<SHVDN::Log::Level>(pendingMessageInfo->Count);
+        List<String^>^ messages = gcnew List<String^>(pendingMessageInfo->Count);
         for each (LogMessageInfo messageInfo in pendingMessageInfo)
         {
             // Don't use Log.WriteToConsole here, we want to make sure that log strings will print via
@@ -287,13 +320,17 @@ internal:
             switch (messageInfo.level)
             {
             case SHVDN::Log::Level::Error:
-                console->PrintError(messageInfo.message);
-                break;
             case SHVDN::Log::Level::Warning:
-                console->PrintWarning(messageInfo.message);
+                levels->Add(messageInfo.level);
+                messages->Add(messageInfo.message);
                 break;
             }
         }
+
+        if (messages->Count != 0)
+        {
+            console->PrintMessages(levels->ToArray(), messages->ToArray());
+        }
     }
 
     static void UpdatePrimaryKeyboardStateCache(unsigned char keyCode, bool down)
@@ -645,8 +682,8 @@ static void ScriptHookVDotNet_ManagedInit()
         console->CommandHistory = stashedConsoleCommandHistory;
 
         // Print welcome message
-        console->PrintInfo("~c~--- Community Script Hook V .NET " SHVDN_VERSION " ---");
-        console->PrintInfo("~c~--- Type \"Help()\" to print an overview of available commands ---");
+        console->PrintInfo("~c~--- Community Script Hook V .NET " SHVDN_VERSION " ---\n"
+            "~c~--- Type \"Help()\" to print an overview of available commands ---");
 
         ScriptHookVDotNet::SendPendingMessagesToConsole(console, pendingLogMessageInfo);
 
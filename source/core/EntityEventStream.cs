@@ -0,0 +1,232 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// Represents a new damage record of a ped or vehicle.
+    /// </summary>
+    public readonly struct EntityDamageEvent
+    {
+        internal EntityDamageEvent(int victimHandle, int attackerHandle, int weaponHash, int gameTime)
+        {
+            VictimHandle = victimHandle;
+            AttackerHandle = attackerHandle;
+            WeaponHash = weaponHash;
+            GameTime = gameTime;
+        }
+
+        /// <summary>
+        /// Gets the handle of the entity that took damage.
+        /// </summary>
+        public int VictimHandle { get; }
+        /// <summary>
+        /// Gets the handle of the entity that caused the damage, or zero if there is none.
+        /// </summary>
+        public int AttackerHandle { get; }
+        /// <summary>
+        /// Gets the hash of the weapon the damage was caused with.
+        /// </summary>
+        public int WeaponHash { get; }
+        /// <summary>
+        /// Gets the game time when the damage was taken.
+        /// </summary>
+        public int GameTime { get; }
+    }
+
+    /// <summary>
+    /// Represents a ped or vehicle starting to touch another ped, vehicle or object.
+    /// </summary>
+    public readonly struct EntityCollisionEvent
+    {
+        internal EntityCollisionEvent(int entityHandle, int otherEntityHandle)
+        {
+            EntityHandle = entityHandle;
+            OtherEntityHandle = otherEntityHandle;
+        }
+
+        /// <summary>
+        /// Gets the handle of the ped or vehicle that recorded the collision.
+        /// </summary>
+        public int EntityHandle { get; }
+        /// <summary>
+        /// Gets the handle of the entity it collided with.
+        /// </summary>
+        public int OtherEntityHandle { get; }
+    }
+
+    /// <summary>
+    /// Scans the damage and collision records of all peds and vehicles once per frame and publishes the ones that
+    /// changed since the previous frame to two channels of the <see cref="ScriptMessageBus"/>.
+    /// </summary>
+    /// <remarks>
+    /// This replaces scripts polling the records of every entity they care about each tick. The damage and collision
+    /// records are each only scanned while at least one script is subscribed to their channel, and all buffers are
+    /// reused, so the scan does not allocate once warmed up. Script handles are only created for entities that take
+    /// part in a published event.
+    /// A damage record is published when its attacker and game time pair was not in the records of the entity in the
+    /// previous frame, so the game timer being the same for a whole frame does not hide damage recorded after the scan
+    /// or by a second attacker in the same millisecond.
+    /// The collision record only tells which entity was touched last, so a collision is published in the first frame
+    /// the entity touches another one: when it did not record a collision in the previous frame, or recorded one with
+    /// a different entity.
+    /// </remarks>
+    internal sealed class EntityEventStream
+    {
+        internal const string DamageChannelName = "SHVDN.EntityDamage";
+        internal const string CollisionChannelName = "SHVDN.EntityCollision";
+
+        // The game keeps far fewer attackers than this per entity, records beyond it are not tracked
+        private const int MaxTrackedDamageRecordCount = 8;
+
+        private unsafe struct TrackedEntity
+        {
+            internal int DamageRecordCount;
+            internal fixed ulong DamageAttackerAddresses[MaxTrackedDamageRecordCount];
+            internal fixed int DamageGameTimes[MaxTrackedDamageRecordCount];
+            internal ulong LastCollidedEntityAddress;
+            internal uint LastCollisionFrame;
+            internal uint LastSeenFrame;
+        }
+
+        private readonly ScriptMessageChannel<EntityDamageEvent> _damageChannel;
+        private readonly ScriptMessageChannel<EntityCollisionEvent> _collisionChannel;
+        private readonly Dictionary<ulong, TrackedEntity> _trackedEntities = new();
+        private readonly List<ulong> _removedEntities = new();
+        private ulong[] _entityAddresses = Array.Empty<ulong>();
+        private uint _frame;
+        private bool _wasScanningDamage;
+        private bool _wasScanningCollisions;
+
+        internal EntityEventStream(ScriptMessageBus messageBus)
+        {
+            _damageChannel = messageBus.CreateDomainChannel<EntityDamageEvent>(DamageChannelName, 256);
+            _collisionChannel = messageBus.CreateDomainChannel<EntityCollisionEvent>(CollisionChannelName, 256);
+        }
+
+        /// <summary>
+        /// Diffs the records of all peds and vehicles against the previous frame. Must be called on the main thread.
+        /// </summary>
+        internal unsafe void Update()
+        {
+            bool scanDamage = _damageChannel.SubscriptionCount != 0;
+            bool scanCollisions = _collisionChannel.SubscriptionCount != 0;
+            if (!scanDamage && !scanCollisions)
+            {
+                _trackedEntities.Clear();
+                _frame = 0;
+                _wasScanningDamage = false;
+                _wasScanningCollisions = false;
+                return;
+            }
+
+            _frame++;
+
+            // Records that already exist when a channel gets its first subscriber are only taken as the baseline, so
+            // subscribers only get what happens from then on
+            bool publishDamage = _wasScanningDamage;
+            bool publishCollisions = _wasScanningCollisions;
+            _wasScanningDamage = scanDamage;
+            _wasScanningCollisions = scanCollisions;
+
+            int entityCount = NativeMemory.CopyPedAndVehicleAddresses(ref _entityAddresses);
+            for (int i = 0; i < entityCount; i++)
+            {
+                ulong address = _entityAddresses[i];
+                _trackedEntities.TryGetValue(address, out TrackedEntity tracked);
+
+                int entityHandle = 0;
+
+                if (scanDamage)
+                {
+                    int damageRecordCount = Math.Min(NativeMemory.GetDamageRecordCount(address, out ulong cAttackerArrayAddress), MaxTrackedDamageRecordCount);
+                    TrackedEntity previous = tracked;
+                    for (int j = 0; j < damageRecordCount; j++)
+                    {
+                        NativeMemory.ReadDamageRecord(cAttackerArrayAddress, j, out ulong attackerAddress, out int weaponHash, out int gameTime);
+                        tracked.DamageAttackerAddresses[j] = attackerAddress;
+                        tracked.DamageGameTimes[j] = gameTime;
+
+                        if (ContainsDamageRecord(ref previous, attackerAddress, gameTime))
+                        {
+                            continue;
+                        }
+
+                        if (publishDamage)
+                        {
+                            if (entityHandle == 0)
+                            {
+                                entityHandle = NativeMemory.CreateEntityHandleOnMainThread(address);
+                            }
+
+                            int attackerHandle = attackerAddress != 0 ? NativeMemory.CreateEntityHandleOnMainThread(attackerAddress) : 0;
+                            _damageChannel.Publish(new EntityDamageEvent(entityHandle, attackerHandle, weaponHash, gameTime));
+                        }
+                    }
+                    tracked.DamageRecordCount = damageRecordCount;
+                }
+                else
+                {
+                    // Not tracked while nobody listens, so the next scan takes the records as the baseline again
+                    tracked.DamageRecordCount = 0;
+                }
+
+                if (scanCollisions)
+                {
+                    ulong collidedEntityAddress = NativeMemory.GetLastCollidedPhysicalAddress(address);
+                    if (collidedEntityAddress != 0)
+                    {
+                        bool isNewContact = tracked.LastCollisionFrame != _frame - 1 || collidedEntityAddress != tracked.LastCollidedEntityAddress;
+                        if (publishCollisions && isNewContact)
+                        {
+                            if (entityHandle == 0)
+                            {
+                                entityHandle = NativeMemory.CreateEntityHandleOnMainThread(address);
+                            }
+
+                            _collisionChannel.Publish(new EntityCollisionEvent(entityHandle, NativeMemory.CreateEntityHandleOnMainThread(collidedEntityAddress)));
+                        }
+
+                        tracked.LastCollisionFrame = _frame;
+                    }
+                    tracked.LastCollidedEntityAddress = collidedEntityAddress;
+                }
+
+                tracked.LastSeenFrame = _frame;
+                _trackedEntities[address] = tracked;
+            }
+
+            // Forget deleted entities, so a new entity that reuses the address does not inherit their records
+            foreach (KeyValuePair<ulong, TrackedEntity> entry in _trackedEntities)
+            {
+                if (entry.Value.LastSeenFrame != _frame)
+                {
+                    _removedEntities.Add(entry.Key);
+                }
+            }
+            foreach (ulong address in _removedEntities)
+            {
+                _trackedEntities.Remove(address);
+            }
+            _removedEntities.Clear();
+        }
+
+        private static unsafe bool ContainsDamageRecord(ref TrackedEntity tracked, ulong attackerAddress, int gameTime)
+        {
+            for (int i = 0; i < tracked.DamageRecordCount; i++)
+            {
+                if (tracked.DamageAttackerAddresses[i] == attackerAddress && tracked.DamageGameTimes[i] == gameTime)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    }
+}
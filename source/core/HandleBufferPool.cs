@@ -0,0 +1,57 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// A small pool of <see cref="int"/> arrays to copy handles into, so enumerating blips or checkpoints every frame
+    /// does not allocate once the pool has warmed up.
+    /// </summary>
+    public static class HandleBufferPool
+    {
+        // Only a few enumerations are ever in flight at once, since scripts run one after another
+        private const int MaxPooledBufferCount = 8;
+
+        private static readonly Stack<int[]> s_buffers = new();
+
+        /// <summary>
+        /// Takes an array with at least the given length out of the pool, or creates one if there is none.
+        /// </summary>
+        public static int[] Rent(int minimumLength)
+        {
+            lock (s_buffers)
+            {
+                if (s_buffers.Count != 0 && s_buffers.Peek().Length >= minimumLength)
+                {
+                    return s_buffers.Pop();
+                }
+            }
+
+            return new int[Math.Max(minimumLength, 16)];
+        }
+
+        /// <summary>
+        /// Puts an array back into the pool. The array must not be used after this.
+        /// </summary>
+        public static void Return(int[] buffer)
+        {
+            if (buffer == null || buffer.Length == 0)
+            {
+                return;
+            }
+
+            lock (s_buffers)
+            {
+                if (s_buffers.Count < MaxPooledBufferCount)
+                {
+                    s_buffers.Push(buffer);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+namespace SHVDN
+{
+    /// <summary>
+    /// Tracks a set of handles and counts how many times it changed, comparing it at most once per frame.
+    /// </summary>
+    internal sealed class HandleSetGeneration
+    {
+        internal delegate int CopyHandles(ref int[] handles);
+
+        private readonly CopyHandles _copyHandles;
+        private readonly object _lock = new();
+        private int[] _handles = new int[16];
+        private int[] _scratch = new int[16];
+        private int _count;
+        private int _generation;
+        private long _lastCheckedFrame = -1;
+
+        internal HandleSetGeneration(CopyHandles copyHandles)
+        {
+            _copyHandles = copyHandles;
+        }
+
+        /// <summary>
+        /// Gets the number of times the set changed, comparing it with the previous one first if that has not been
+        /// done in the current frame yet.
+        /// </summary>
+        internal int Get(long frameCount)
+        {
+            lock (_lock)
+            {
+                if (_lastCheckedFrame == frameCount)
+                {
+                    return _generation;
+                }
+
+                _lastCheckedFrame = frameCount;
+
+                int count = _copyHandles(ref _scratch);
+                if (!Equals(_scratch, count))
+                {
+                    (_handles, _scratch) = (_scratch, _handles);
+                    _count = count;
+                    _generation++;
+                }
+
+                return _generation;
+            }
+        }
+
+        private bool Equals(int[] handles, int count)
+        {
+            if (count != _count)
+            {
+                return false;
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                if (handles[i] != _handles[i])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+}
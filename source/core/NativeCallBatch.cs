@@ -0,0 +1,171 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// A reusable list of script function calls that can be executed in one go with
+    /// <see cref="NativeFunc.InvokeBatch(NativeCallBatch)"/>.
+    /// </summary>
+    /// <remarks>
+    /// Executing the calls in a batch only switches the TLS context and resets the timeout stopwatch once instead of
+    /// once per call. The storage of a batch is kept when it is cleared, so a batch that is rebuilt every frame does
+    /// not allocate once it is warmed up. This class is not thread-safe.
+    /// </remarks>
+    public sealed unsafe class NativeCallBatch
+    {
+        private struct CallEntry
+        {
+            internal ulong _hash;
+            internal int _argStart;
+            internal int _argCount;
+        }
+
+        private CallEntry[] _calls;
+        private ulong[] _args;
+        private int _callCount;
+        private int _argCount;
+        // The indices of the arguments that hold entity addresses, which are replaced with handles before the calls
+        private int[] _entityArgIndices = Array.Empty<int>();
+        private int _entityArgCount;
+
+        public NativeCallBatch() : this(16, 128)
+        {
+        }
+        public NativeCallBatch(int callCapacity, int argumentCapacity)
+        {
+            _calls = new CallEntry[Math.Max(callCapacity, 1)];
+            _args = new ulong[Math.Max(argumentCapacity, 1)];
+        }
+
+        /// <summary>
+        /// Gets the number of calls recorded in this batch.
+        /// </summary>
+        public int Count => _callCount;
+
+        /// <summary>
+        /// Gets the hash of the last call recorded in this batch, or zero if the batch is empty.
+        /// </summary>
+        public ulong LastHash => _callCount != 0 ? _calls[_callCount - 1]._hash : 0;
+
+        /// <summary>
+        /// Gets whether this batch has entity arguments whose handles have not been created yet.
+        /// </summary>
+        internal bool HasEntityArguments => _entityArgCount != 0;
+
+        /// <summary>
+        /// Removes all the recorded calls without releasing the underlying storage.
+        /// </summary>
+        public void Clear()
+        {
+            _callCount = 0;
+            _argCount = 0;
+            _entityArgCount = 0;
+        }
+
+        /// <summary>
+        /// Starts recording a new call. The arguments pushed with <c>PushArgument</c> until the next call to this
+        /// method belong to this call.
+        /// </summary>
+        /// <param name="hash">The function hash to call.</param>
+        public void BeginCall(ulong hash)
+        {
+            if (_callCount == _calls.Length)
+            {
+                Array.Resize(ref _calls, _calls.Length * 2);
+            }
+
+            _calls[_callCount++] = new CallEntry { _hash = hash, _argStart = _argCount, _argCount = 0 };
+        }
+
+        /// <summary>
+        /// Adds an argument to the call that was most recently started with <see cref="BeginCall(ulong)"/>.
+        /// </summary>
+        public void PushArgument(ulong value)
+        {
+            if (_callCount == 0)
+            {
+                throw new InvalidOperationException("BeginCall must be called before pushing arguments.");
+            }
+
+            if (_argCount == _args.Length)
+            {
+                Array.Resize(ref _args, _args.Length * 2);
+            }
+
+            _args[_argCount++] = value;
+            _calls[_callCount - 1]._argCount++;
+        }
+        public void PushArgument(int value) => PushArgument((ulong)value);
+        public void PushArgument(bool value) => PushArgument(value ? 1ul : 0ul);
+        public void PushArgument(float value) => PushArgument((ulong)*(uint*)&value);
+        public void PushArgument(IntPtr value) => PushArgument((ulong)value.ToInt64());
+        /// <summary>
+        /// Adds an entity of the snapshot passed to a compute handler as an argument. The script handle of the entity is
+        /// only created on the main thread right before the calls are executed.
+        /// </summary>
+        /// <exception cref="InvalidOperationException">Not called from a compute handler.</exception>
+        public void PushArgument(in FrameEntity entity)
+        {
+            if (ScriptComputePhase.ComputingScript == null)
+            {
+                throw new InvalidOperationException("Entities of a frame snapshot can only be passed from a compute handler.");
+            }
+
+            PushArgument(entity.Address);
+
+            if (_entityArgCount == _entityArgIndices.Length)
+            {
+                Array.Resize(ref _entityArgIndices, Math.Max(_entityArgIndices.Length * 2, 4));
+            }
+            _entityArgIndices[_entityArgCount++] = _argCount - 1;
+        }
+
+        /// <summary>
+        /// Replaces the entity addresses pushed with <see cref="PushArgument(in FrameEntity)"/> with script handles.
+        /// Must be called on the main thread in the same frame the addresses were read.
+        /// </summary>
+        /// <returns>The number of entities no handle could be created for, which are passed as zero.</returns>
+        internal int ResolveEntityArguments()
+        {
+            int unresolvedCount = 0;
+            for (int i = 0; i < _entityArgCount; i++)
+            {
+                ref ulong arg = ref _args[_entityArgIndices[i]];
+                arg = (ulong)NativeMemory.CreateEntityHandleOnMainThread(arg);
+                if (arg == 0)
+                {
+                    unresolvedCount++;
+                }
+            }
+
+            _entityArgCount = 0;
+            return unresolvedCount;
+        }
+
+        /// <summary>
+        /// Executes all the recorded calls in order. This may only be called from the main script domain thread or
+        /// from a task that runs with the TLS context of the main thread of the game.
+        /// </summary>
+        /// <returns>A pointer to the return value of the last call, or <see langword="null" /> if the batch is empty.</returns>
+        internal ulong* InvokeInternal()
+        {
+            ulong* result = null;
+
+            fixed (ulong* argBase = _args)
+            {
+                for (int i = 0; i < _callCount; i++)
+                {
+                    CallEntry call = _calls[i];
+                    result = NativeFunc.InvokeInternal(call._hash, argBase + call._argStart, call._argCount);
+                }
+            }
+
+            return result;
+        }
+    }
+}
@@ -52,6 +52,7 @@ namespace SHVDN
 
             public void Run()
             {
+                ScriptMetrics.CountNativeCalls(1);
                 _result = InvokeInternal(_hash, _arguments);
             }
         }
@@ -68,10 +69,29 @@ namespace SHVDN
 
             public void Run()
             {
+                ScriptMetrics.CountNativeCalls(1);
                 _result = InvokeInternal(_hash, _argumentPtr, _argumentCount);
             }
         }
 
+        /// <summary>
+        /// Internal script task which executes all the calls recorded in a <see cref="NativeCallBatch"/>.
+        /// </summary>
+        private class NativeTaskBatch : IScriptTask
+        {
+            internal NativeCallBatch _batch;
+            internal ulong* _result;
+
+            public void Run()
+            {
+                ScriptMetrics.CountNativeCalls(_batch.Count);
+                _result = _batch.InvokeInternal();
+            }
+        }
+
+        [ThreadStatic]
+        private static NativeTaskBatch s_nativeTaskBatch;
+
         /// <summary>
         /// Pushes a single string component on the text stack.
         /// </summary>
@@ -302,6 +322,48 @@ namespace SHVDN
         {
             return Invoke(hash, ConvertPrimitiveArguments(args));
         }
+        /// <summary>
+        /// Executes all the script functions recorded in <paramref name="batch"/> inside the current script domain
+        /// with only one switch to the TLS context of the main thread.
+        /// </summary>
+        /// <param name="batch">The calls to execute. This method does not clear the batch.</param>
+        /// <returns>A pointer to the return value of the last call, or <see langword="null" /> if the batch is empty.</returns>
+        public static ulong* InvokeBatch(NativeCallBatch batch)
+        {
+            if (batch == null)
+            {
+                throw new ArgumentNullException(nameof(batch));
+            }
+            if (batch.Count == 0)
+            {
+                return null;
+            }
+            if (batch.HasEntityArguments)
+            {
+                throw new InvalidOperationException("Batches with entities of a frame snapshot are executed by the compute phase and cannot be executed directly.");
+            }
+
+            ScriptDomain domain = ScriptDomain.CurrentDomain;
+            if (domain == null)
+            {
+                ThrowInvalidOperationException_IllegalScriptingCall();
+                return null;
+            }
+
+            // Reuse one task object per calling thread, since the task always runs before this method returns
+            NativeTaskBatch task = s_nativeTaskBatch ??= new NativeTaskBatch();
+            task._batch = batch;
+            try
+            {
+                domain.ExecuteTaskWithGameThreadTlsContext(task);
+            }
+            finally
+            {
+                task._batch = null;
+            }
+
+            return task._result;
+        }
 
         private static void ThrowInvalidOperationException_IllegalScriptingCall()
         {
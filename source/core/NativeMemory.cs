@@ -391,6 +391,8 @@ namespace SHVDN
             address = MemScanner.FindPatternBmh("\x48\x8B\x42\x20\x48\x85\xC0\x74\x09\xF3\x0F\x10\x80", "xxxxxxxxxxxxx");
             if (address != null)
             {
+                // The health is read right before it is divided by the max health
+                EntityHealthOffset = *(int*)(address + 13);
                 EntityMaxHealthOffset = *(int*)(address + 0x25);
             }
 
@@ -1406,6 +1408,7 @@ namespace SHVDN
 
         #region -- CPhysical Offsets --
 
+        public static int EntityHealthOffset { get; }
         public static int EntityMaxHealthOffset { get; }
         public static int SetAngularVelocityVFuncOfEntityOffset { get; }
         public static int GetAngularVelocityVFuncOfEntityOffset { get; }
@@ -1702,6 +1705,67 @@ namespace SHVDN
             return new IntPtr(targetCEntityAddress);
         }
 
+        /// <summary>
+        /// Gets the number of damage records of a <c>CPhysical</c> and the address of the array they are stored in.
+        /// Used by <see cref="EntityEventStream"/>, which reads the records of all peds and vehicles every frame.
+        /// </summary>
+        internal static int GetDamageRecordCount(ulong cPhysicalAddress, out ulong cAttackerArrayAddress)
+        {
+            cAttackerArrayAddress = 0;
+            if (CAttackerArrayOfEntityOffset == 0 ||
+                ElementCountOfCAttackerArrayOfEntityOffset == 0 ||
+                ElementSizeOfCAttackerArrayOfEntity == 0)
+            {
+                return 0;
+            }
+
+            cAttackerArrayAddress = *(ulong*)(cPhysicalAddress + (ulong)CAttackerArrayOfEntityOffset);
+            if (cAttackerArrayAddress == 0)
+            {
+                return 0;
+            }
+
+            return *(int*)((byte*)cAttackerArrayAddress + ElementCountOfCAttackerArrayOfEntityOffset);
+        }
+
+        internal static void ReadDamageRecord(ulong cAttackerArrayAddress, int index, out ulong attackerEntityAddress, out int weaponHash, out int gameTime)
+        {
+            var cAttacker = (CAttacker*)((byte*)cAttackerArrayAddress + index * ElementSizeOfCAttackerArrayOfEntity);
+
+            attackerEntityAddress = cAttacker->attackerEntityAddress;
+            weaponHash = cAttacker->weaponHash;
+            gameTime = cAttacker->gameTime;
+        }
+
+        /// <summary>
+        /// Gets the address of the ped, vehicle or object in the last collision record of a <c>CPhysical</c>, or zero if
+        /// it has no such record.
+        /// </summary>
+        internal static ulong GetLastCollidedPhysicalAddress(ulong cPhysicalAddress)
+        {
+            if (CAttackerArrayOfEntityOffset == 0 || !CPhysicalRecordsCollision(new IntPtr((long)cPhysicalAddress)))
+            {
+                return 0;
+            }
+
+            long** collisionRecord = *(long***)(cPhysicalAddress + (ulong)CAttackerArrayOfEntityOffset + 0x30);
+            if (collisionRecord == null || *collisionRecord == null)
+            {
+                return 0;
+            }
+
+            ulong targetCEntityAddress = (ulong)*collisionRecord;
+            switch ((EntityTypeInternal)(*(byte*)(targetCEntityAddress + 0x28)))
+            {
+                case EntityTypeInternal.Vehicle:
+                case EntityTypeInternal.Ped:
+                case EntityTypeInternal.Object:
+                    return targetCEntityAddress;
+                default:
+                    return 0;
+            }
+        }
+
         private enum EntityTypeInternal
         {
             Invalid = 0,
@@ -3095,6 +3159,16 @@ namespace SHVDN
 
         private static IntPtr FindCModelInfo(int modelHash)
         {
+            return TryGetIndexedModel(modelHash, out ModelIndexEntry entry) ? entry.ModelInfo : IntPtr.Zero;
+        }
+
+        private static IntPtr FindCModelInfoUncached(int modelHash)
+        {
+            if (s_modelHashTable == 0)
+            {
+                return IntPtr.Zero;
+            }
+
             for (HashNode* cur = ((HashNode**)s_modelHashTable)[(uint)(modelHash) % s_modelHashEntries]; cur != null; cur = cur->next)
             {
                 if (cur->hash != modelHash)
@@ -3153,14 +3227,12 @@ namespace SHVDN
         }
         public static int GetVehicleType(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-
-            if (modelInfo == IntPtr.Zero)
+            if (!TryGetIndexedModel(modelHash, out ModelIndexEntry entry))
             {
                 return -1;
             }
 
-            return (int)GetVehicleStructClass(modelInfo);
+            return (int)entry.VehicleClass;
         }
 
         private static IntPtr GetModelInfo(IntPtr entityAddress)
@@ -3267,47 +3339,38 @@ namespace SHVDN
 
         public static bool IsModelAPed(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-            return GetModelInfoClass(modelInfo) == ModelInfoClassType.Ped;
+            return TryGetIndexedModel(modelHash, out ModelIndexEntry entry) && entry.ClassType == ModelInfoClassType.Ped;
         }
         public static bool IsModelABlimp(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-            return GetVehicleStructClass(modelInfo) == VehicleStructClassType.Blimp;
+            return TryGetIndexedModel(modelHash, out ModelIndexEntry entry) && entry.VehicleClass == VehicleStructClassType.Blimp;
         }
         public static bool IsModelAMotorcycle(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-            return GetVehicleStructClass(modelInfo) == VehicleStructClassType.Bike;
+            return TryGetIndexedModel(modelHash, out ModelIndexEntry entry) && entry.VehicleClass == VehicleStructClassType.Bike;
         }
         public static bool IsModelASubmarine(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-            return GetVehicleStructClass(modelInfo) == VehicleStructClassType.Submarine;
+            return TryGetIndexedModel(modelHash, out ModelIndexEntry entry) && entry.VehicleClass == VehicleStructClassType.Submarine;
         }
         public static bool IsModelASubmarineCar(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-            return GetVehicleStructClass(modelInfo) == VehicleStructClassType.SubmarineCar;
+            return TryGetIndexedModel(modelHash, out ModelIndexEntry entry) && entry.VehicleClass == VehicleStructClassType.SubmarineCar;
         }
         public static bool IsModelATrailer(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-            return GetVehicleStructClass(modelInfo) == VehicleStructClassType.Trailer;
+            return TryGetIndexedModel(modelHash, out ModelIndexEntry entry) && entry.VehicleClass == VehicleStructClassType.Trailer;
         }
         public static bool IsModelAMlo(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-            return GetModelInfoClass(modelInfo) == ModelInfoClassType.Mlo;
+            return TryGetIndexedModel(modelHash, out ModelIndexEntry entry) && entry.ClassType == ModelInfoClassType.Mlo;
         }
 
         public static string GetVehicleMakeName(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-
-            if (GetModelInfoClass(modelInfo) == ModelInfoClassType.Vehicle)
+            if (TryGetIndexedModel(modelHash, out ModelIndexEntry entry) && entry.ClassType == ModelInfoClassType.Vehicle)
             {
-                return StringMarshal.PtrToStringUtf8(modelInfo + s_vehicleMakeNameOffsetInModelInfo);
+                return StringMarshal.PtrToStringUtf8(entry.ModelInfo + s_vehicleMakeNameOffsetInModelInfo);
             }
 
             return "CARNOTFOUND";
@@ -3322,14 +3385,13 @@ namespace SHVDN
                 return false;
             }
 
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-
-            if (GetModelInfoClass(modelInfo) != ModelInfoClassType.Vehicle)
+            if (!TryGetIndexedModel(modelHash, out ModelIndexEntry entry) || entry.ClassType != ModelInfoClassType.Vehicle)
             {
                 return false;
             }
 
-            ulong modelFlags = *(ulong*)(modelInfo + Vehicle.FirstVehicleFlagsOffset + flagOffset).ToPointer();
+            // Read the flags every time rather than caching them, since other mods may patch them at runtime
+            ulong modelFlags = *(ulong*)(entry.ModelInfo + Vehicle.FirstVehicleFlagsOffset + flagOffset).ToPointer();
             return (modelFlags & flag) != 0;
         }
 
@@ -3344,13 +3406,12 @@ namespace SHVDN
 
         public static IntPtr GetHandlingDataByModelHash(int modelHash)
         {
-            IntPtr modelInfo = FindCModelInfo(modelHash);
-            if (GetModelInfoClass(modelInfo) != ModelInfoClassType.Vehicle)
+            if (!TryGetIndexedModel(modelHash, out ModelIndexEntry entry) || entry.ClassType != ModelInfoClassType.Vehicle)
             {
                 return IntPtr.Zero;
             }
 
-            int handlingIndex = *(int*)(modelInfo + s_handlingIndexOffsetInModelInfo).ToPointer();
+            int handlingIndex = *(int*)(entry.ModelInfo + s_handlingIndexOffsetInModelInfo).ToPointer();
             return new IntPtr((long)s_getHandlingDataByIndex(handlingIndex));
         }
         public static IntPtr GetHandlingDataByHandlingNameHash(int handlingNameHash)
@@ -3437,6 +3498,282 @@ namespace SHVDN
 
         #endregion
 
+        #region -- Metadata Index --
+
+        /// <summary>
+        /// An open addressing hash table from game hashes to values. It is never modified once built, so lookups need no lock.
+        /// </summary>
+        private sealed class HashIndex<T> where T : struct
+        {
+            private readonly uint[] _keys;
+            private readonly T[] _values;
+            private readonly int _mask;
+
+            internal HashIndex(List<KeyValuePair<uint, T>> entries)
+            {
+                // Keep the load factor at 50% or less so probe sequences stay short
+                int capacity = 16;
+                while (capacity < entries.Count * 2)
+                {
+                    capacity <<= 1;
+                }
+
+                _keys = new uint[capacity];
+                _values = new T[capacity];
+                _mask = capacity - 1;
+
+                foreach (KeyValuePair<uint, T> entry in entries)
+                {
+                    // Zero marks empty slots, and is never a valid hash of an item anyway
+                    if (entry.Key == 0)
+                    {
+                        continue;
+                    }
+
+                    int i = (int)entry.Key & _mask;
+                    while (_keys[i] != 0 && _keys[i] != entry.Key)
+                    {
+                        i = (i + 1) & _mask;
+                    }
+
+                    _keys[i] = entry.Key;
+                    _values[i] = entry.Value;
+                }
+            }
+
+            internal bool TryGetValue(uint key, out T value)
+            {
+                if (key != 0)
+                {
+                    // Joaat hashes are well distributed, so the low bits are good enough as the initial slot
+                    for (int i = (int)key & _mask; _keys[i] != 0; i = (i + 1) & _mask)
+                    {
+                        if (_keys[i] == key)
+                        {
+                            value = _values[i];
+                            return true;
+                        }
+                    }
+                }
+
+                value = default;
+                return false;
+            }
+        }
+
+        private struct ModelIndexEntry
+        {
+            internal IntPtr ModelInfo;
+            internal ushort Slot;
+            internal ModelInfoClassType ClassType;
+            internal VehicleStructClassType VehicleClass;
+        }
+
+        private sealed class ModelIndex
+        {
+            internal HashIndex<ModelIndexEntry> Entries;
+            internal int[] PedModelHashes;
+            internal int[] VehicleModelHashes;
+        }
+
+        private static readonly object s_metadataIndexLock = new();
+        private static ModelIndex s_modelIndex;
+        // Set when the game knows a model the index does not, which happens when DLCs are loaded or unloaded
+        private static volatile bool s_isModelIndexStale;
+
+        /// <summary>
+        /// Discards the cached model, weapon and weapon component metadata, so it is read from the game again on the next lookup.
+        /// </summary>
+        /// <remarks>
+        /// The caches detect changes of the game data by themselves, so this is only needed if the game data is modified
+        /// in a way they cannot notice (e.g. by other mods replacing model infos in place).
+        /// </remarks>
+        public static void InvalidateMetadataIndex()
+        {
+            lock (s_metadataIndexLock)
+            {
+                s_modelIndex = null;
+                s_weaponIndex = null;
+                s_weaponComponentIndex = null;
+            }
+        }
+
+        private static ModelIndex GetModelIndex()
+        {
+            ModelIndex index = System.Threading.Volatile.Read(ref s_modelIndex);
+            if (index != null && !s_isModelIndexStale)
+            {
+                return index;
+            }
+
+            lock (s_metadataIndexLock)
+            {
+                if (s_modelIndex == null || s_isModelIndexStale)
+                {
+                    s_isModelIndexStale = false;
+                    System.Threading.Volatile.Write(ref s_modelIndex, BuildModelIndex());
+                }
+
+                return s_modelIndex;
+            }
+        }
+
+        private static ModelIndex BuildModelIndex()
+        {
+            var entries = new List<KeyValuePair<uint, ModelIndexEntry>>(s_modelNum1 != 0 ? (int)s_modelNum1 : 0);
+            var pedModelHashes = new List<int>();
+            var vehicleModelHashes = new List<int>();
+
+            for (int i = 0; s_modelHashTable != 0 && i < s_modelHashEntries; i++)
+            {
+                for (HashNode* cur = ((HashNode**)s_modelHashTable)[i]; cur != null; cur = cur->next)
+                {
+                    if (!TryGetModelInfoInSlot(cur->data, out IntPtr modelInfo))
+                    {
+                        continue;
+                    }
+
+                    ModelIndexEntry entry = CreateModelIndexEntry(modelInfo, cur->data);
+                    entries.Add(new KeyValuePair<uint, ModelIndexEntry>((uint)cur->hash, entry));
+
+                    switch (entry.ClassType)
+                    {
+                        case ModelInfoClassType.Ped:
+                            pedModelHashes.Add(cur->hash);
+                            break;
+                        case ModelInfoClassType.Vehicle:
+                            vehicleModelHashes.Add(cur->hash);
+                            break;
+                    }
+                }
+            }
+
+            return new ModelIndex
+            {
+                Entries = new HashIndex<ModelIndexEntry>(entries),
+                PedModelHashes = pedModelHashes.ToArray(),
+                VehicleModelHashes = vehicleModelHashes.ToArray(),
+            };
+        }
+
+        private static ModelIndexEntry CreateModelIndexEntry(IntPtr modelInfo, ushort slot)
+        {
+            return new ModelIndexEntry
+            {
+                ModelInfo = modelInfo,
+                Slot = slot,
+                ClassType = GetModelInfoClass(modelInfo),
+                VehicleClass = GetVehicleStructClass(modelInfo),
+            };
+        }
+
+        private static bool TryGetModelInfoInSlot(ushort slot, out IntPtr modelInfo)
+        {
+            modelInfo = IntPtr.Zero;
+
+            bool bitTest = ((*(int*)(s_modelNum2 + (ulong)(4 * slot >> 5))) & (1 << (slot & 0x1F))) != 0;
+            if (slot >= s_modelNum1 || !bitTest)
+            {
+                return false;
+            }
+
+            ulong addr1 = s_modelNum4 + s_modelNum3 * slot;
+            if (addr1 == 0)
+            {
+                return false;
+            }
+
+            modelInfo = new IntPtr(*(long*)addr1);
+            return modelInfo != IntPtr.Zero;
+        }
+
+        private static bool TryGetIndexedModel(int modelHash, out ModelIndexEntry entry)
+        {
+            // The slot of the entry may have been freed or reused since the index was built, so check it still
+            // holds the same model before trusting the entry
+            if (GetModelIndex().Entries.TryGetValue((uint)modelHash, out entry)
+                && TryGetModelInfoInSlot(entry.Slot, out IntPtr modelInfo)
+                && modelInfo == entry.ModelInfo
+                && GetModelHashFromFwArcheType(modelInfo) == modelHash)
+            {
+                return true;
+            }
+
+            IntPtr uncachedModelInfo = FindCModelInfoUncached(modelHash);
+            if (uncachedModelInfo == IntPtr.Zero)
+            {
+                entry = default;
+                return false;
+            }
+
+            // The game knows the model but the index does not, so rebuild the index on the next lookup
+            s_isModelIndexStale = true;
+            entry = CreateModelIndexEntry(uncachedModelInfo, 0);
+            return true;
+        }
+
+        /// <summary>
+        /// Gets the hashes of all ped models the game currently knows, including the ones added by DLCs loaded after startup.
+        /// </summary>
+        public static int[] GetAllPedModelHashes() => (int[])GetModelIndex().PedModelHashes.Clone();
+        /// <summary>
+        /// Gets the hashes of all vehicle models the game currently knows, including the ones added by DLCs loaded after startup.
+        /// </summary>
+        public static int[] GetAllVehicleModelHashes() => (int[])GetModelIndex().VehicleModelHashes.Clone();
+
+        /// <summary>
+        /// Checks if each of the models is a ped model.
+        /// </summary>
+        /// <param name="modelHashes">The model hashes to check.</param>
+        /// <param name="results">The array to store the results in, at the same indices as in <paramref name="modelHashes"/>.</param>
+        public static void IsModelAPed(int[] modelHashes, bool[] results)
+        {
+            ThrowIfBulkQueryResultsTooShort(modelHashes.Length, results.Length);
+
+            for (int i = 0; i < modelHashes.Length; i++)
+            {
+                results[i] = TryGetIndexedModel(modelHashes[i], out ModelIndexEntry entry) && entry.ClassType == ModelInfoClassType.Ped;
+            }
+        }
+        /// <summary>
+        /// Gets the vehicle type of each of the models, or -1 for models that do not exist.
+        /// </summary>
+        /// <param name="modelHashes">The model hashes to check.</param>
+        /// <param name="results">The array to store the results in, at the same indices as in <paramref name="modelHashes"/>.</param>
+        public static void GetVehicleTypes(int[] modelHashes, int[] results)
+        {
+            ThrowIfBulkQueryResultsTooShort(modelHashes.Length, results.Length);
+
+            for (int i = 0; i < modelHashes.Length; i++)
+            {
+                results[i] = TryGetIndexedModel(modelHashes[i], out ModelIndexEntry entry) ? (int)entry.VehicleClass : -1;
+            }
+        }
+        /// <summary>
+        /// Gets the handling data of each of the vehicle models, or <see cref="IntPtr.Zero"/> for models that are not vehicles.
+        /// </summary>
+        /// <param name="modelHashes">The model hashes to check.</param>
+        /// <param name="results">The array to store the results in, at the same indices as in <paramref name="modelHashes"/>.</param>
+        public static void GetHandlingDataByModelHashes(int[] modelHashes, IntPtr[] results)
+        {
+            ThrowIfBulkQueryResultsTooShort(modelHashes.Length, results.Length);
+
+            for (int i = 0; i < modelHashes.Length; i++)
+            {
+                results[i] = GetHandlingDataByModelHash(modelHashes[i]);
+            }
+        }
+
+        private static void ThrowIfBulkQueryResultsTooShort(int queryCount, int resultsLength)
+        {
+            if (resultsLength < queryCount)
+            {
+                throw new ArgumentException("The results array must be at least as long as the array of hashes to query.", "results");
+            }
+        }
+
+        #endregion
+
         #region -- Entity Pools --
 
         // Note: actually this struct is supposed to point the same struct type as `FwBasePool` in this source code
@@ -3475,7 +3812,7 @@ namespace SHVDN
         /// <c>CVehicle</c>, <c>audVehicleAudioEntity</c>, and <c>void *</c>.
         /// </remarks>
         [StructLayout(LayoutKind.Explicit)]
-        private struct RageSysMemPoolAllocator
+        internal struct RageSysMemPoolAllocator
         {
             // m_pool at offset 0x0 takes 0x60 byte
             // (type: "rage::atIteratablePool<rage::sysMemPoolAllocator::PoolNode>").
@@ -3502,6 +3839,25 @@ namespace SHVDN
             {
                 return poolAddress[i];
             }
+
+            /// <summary>
+            /// Copies the addresses of all used slots to <paramref name="addresses"/>, starting at
+            /// <paramref name="index"/>. The array must have room for <see cref="size"/> more elements.
+            /// </summary>
+            /// <returns>The index after the last copied address.</returns>
+            internal int CopyAddresses(ulong[] addresses, int index)
+            {
+                uint poolSize = size;
+                for (uint i = 0; i < poolSize; i++)
+                {
+                    if (IsValid(i))
+                    {
+                        addresses[index++] = GetAddress(i);
+                    }
+                }
+
+                return index;
+            }
         }
 
         /// <summary>
@@ -3519,7 +3875,7 @@ namespace SHVDN
         /// </para>
         /// </remarks>
         [StructLayout(LayoutKind.Explicit)]
-        private struct FwBasePool
+        internal struct FwBasePool
         {
             [FieldOffset(0x00)]
             public ulong poolStartAddress;
@@ -3560,6 +3916,25 @@ namespace SHVDN
                 return ((Mask(index) & (poolStartAddress + index * itemSize)));
             }
 
+            /// <summary>
+            /// Copies the addresses of all used slots to <paramref name="addresses"/>, starting at
+            /// <paramref name="index"/>. The array must have room for <see cref="size"/> more elements.
+            /// </summary>
+            /// <returns>The index after the last copied address.</returns>
+            public int CopyAddresses(ulong[] addresses, int index)
+            {
+                uint poolSize = size;
+                for (uint i = 0; i < poolSize; i++)
+                {
+                    if (IsValid(i))
+                    {
+                        addresses[index++] = GetAddress(i);
+                    }
+                }
+
+                return index;
+            }
+
             [MethodImpl(MethodImplOptions.AggressiveInlining)]
             public IntPtr GetAddressFromHandle(int handle)
             {
@@ -4610,6 +4985,24 @@ namespace SHVDN
                     return GetPathNodeLinkUnsafe(index);
                 }
                 internal CPathNodeLink* GetPathNodeLinkUnsafe(uint index) => (CPathNodeLink*)((ulong)NodeLinkArrayPtr + index * (uint)sizeof(CPathNodeLink));
+
+                /// <summary>
+                /// Adds the handles of the vehicle nodes in this region that are in range and match the predicate.
+                /// </summary>
+                internal void AddVehicleNodesInRange(List<int> result, float x, float y, float z, float radius, Func<int, bool> predicateForFlags)
+                {
+                    uint vehicleNodeCountInRegion = NodeCountVehicle;
+                    for (uint j = 0; j < vehicleNodeCountInRegion; j++)
+                    {
+                        CPathNode* vehPathNode = GetPathNodeUnsafe(j);
+                        if (!CheckVehPathNodePropertyPredicateAndPosition(vehPathNode, predicateForFlags, x, y, z, radius))
+                        {
+                            continue;
+                        }
+
+                        result.Add(vehPathNode->GetHandleForNativeFunctions());
+                    }
+                }
             }
 
             private static CPathRegion* GetCPathRegion(uint areaId)
@@ -4989,17 +5382,7 @@ namespace SHVDN
                         continue;
                     }
 
-                    uint vehicleNodeCountInRegion = pathRegion->NodeCountVehicle;
-                    for (uint j = 0; j < vehicleNodeCountInRegion; j++)
-                    {
-                        CPathNode* vehPathNode = pathRegion->GetPathNodeUnsafe(j);
-                        if (!CheckVehPathNodePropertyPredicateAndPosition(vehPathNode, predicateForFlags, x, y, z, radius))
-                        {
-                            continue;
-                        }
-
-                        result.Add(vehPathNode->GetHandleForNativeFunctions());
-                    }
+                    pathRegion->AddVehicleNodesInRange(result, x, y, z, radius, predicateForFlags);
                 }
 
                 return result.ToArray();
@@ -5289,15 +5672,13 @@ namespace SHVDN
         private static int* s_northRadarBlipHandleAddress;
         private static int* s_centerRadarBlipHandleAddress;
 
-        private static bool CheckBlip(ulong blipAddress, FVector3? position, float radius, params int[] spriteTypes)
+        private static readonly HandleSetGeneration s_radarBlipGeneration = new(CopyNonCriticalRadarBlipHandles);
+
+        private static bool CheckBlip(ulong blipAddress, FVector3? position, float radius, BlipSpriteMask spriteMask)
         {
-            if (spriteTypes.Length > 0)
+            if (!spriteMask.MatchesAll && !spriteMask.Contains(*(int*)(blipAddress + 0x40)))
             {
-                int spriteIndex = *(int*)(blipAddress + 0x40);
-                if (!Array.Exists(spriteTypes, x => x == spriteIndex))
-                {
-                    return false;
-                }
+                return false;
             }
 
             if (position == null || !(radius > 0f))
@@ -5348,10 +5729,32 @@ namespace SHVDN
             return GetNonCriticalRadarBlipHandles(null, 0f, spriteTypes);
         }
         public static int[] GetNonCriticalRadarBlipHandles(FVector3? position = default, float radius = 0f, params int[] spriteTypes)
+        {
+            int[] handles = Array.Empty<int>();
+            int count = CopyNonCriticalRadarBlipHandles(ref handles, position, radius,
+                spriteTypes.Length != 0 ? new BlipSpriteMask(spriteTypes) : BlipSpriteMask.All);
+            if (count != handles.Length)
+            {
+                Array.Resize(ref handles, count);
+            }
+
+            return handles;
+        }
+        internal static int CopyNonCriticalRadarBlipHandles(ref int[] handles) => CopyNonCriticalRadarBlipHandles(ref handles, null, 0f, BlipSpriteMask.All);
+        /// <summary>
+        /// Copies the handles of all blips except the north, the center and the placeholder blip without allocating
+        /// if the buffer is big enough.
+        /// </summary>
+        /// <param name="handles">The buffer to store the handles in. Replaced with a bigger one if it is too small.</param>
+        /// <param name="position">The position to check the blips against, or <see langword="null" /> to not filter by position.</param>
+        /// <param name="radius">The maximum distance from <paramref name="position"/>.</param>
+        /// <param name="spriteMask">The sprites of the blips to include.</param>
+        /// <returns>The number of stored handles.</returns>
+        public static int CopyNonCriticalRadarBlipHandles(ref int[] handles, FVector3? position, float radius, BlipSpriteMask spriteMask)
         {
             if (s_radarBlipPoolAddress == null)
             {
-                return Array.Empty<int>();
+                return 0;
             }
 
             int possibleBlipCount = *s_possibleRadarBlipCountAddress;
@@ -5359,7 +5762,12 @@ namespace SHVDN
             int northBlipIndex = GetBlipIndexIfHandleIsValid(*s_northRadarBlipHandleAddress);
             int centerBlipIndex = GetBlipIndexIfHandleIsValid(*s_centerRadarBlipHandleAddress);
 
-            var handles = new List<int>(possibleBlipCount);
+            if (handles.Length < possibleBlipCount)
+            {
+                handles = new int[possibleBlipCount];
+            }
+
+            int count = 0;
 
             // Skip the 3 critical blips, just like GET_FIRST_BLIP_INFO_ID does
             // The 3 critical blips is the north blip, the center blip, and the unknown simple blip (placeholder?).
@@ -5372,18 +5780,24 @@ namespace SHVDN
                     continue;
                 }
 
-                if (!CheckBlip(address, position, radius, spriteTypes))
+                if (!CheckBlip(address, position, radius, spriteMask))
                 {
                     continue;
                 }
 
                 ushort blipCreationIncrement = *(ushort*)(address + 8);
-                handles.Add((int)((blipCreationIncrement << 0x10) + (uint)i));
+                handles[count++] = (int)((blipCreationIncrement << 0x10) + (uint)i);
             }
 
-            return handles.ToArray();
+            return count;
         }
 
+        /// <summary>
+        /// Gets a number that is incremented whenever a non-critical blip is created or deleted. The blips are compared
+        /// at most once per frame, so the number stays the same for the rest of the frame.
+        /// </summary>
+        public static int GetRadarBlipGeneration() => s_radarBlipGeneration.Get(ScriptDomain.CurrentDomain?.FrameCount ?? 0);
+
         public static int GetNorthBlip() => s_northRadarBlipHandleAddress != null ? *s_northRadarBlipHandleAddress : 0;
 
         public static IntPtr GetBlipAddress(int handle)
@@ -5445,7 +5859,9 @@ namespace SHVDN
         {
             #region Fields
             internal CScriptResourceTypeNameIndex _typeNameIndex;
+            // Filled in place and grown when too small, so a task can be reused without allocating
             internal int[] _returnHandles = Array.Empty<int>();
+            internal int _returnCount;
             #endregion
 
             internal GetAllCScriptResourceHandlesTask(CScriptResourceTypeNameIndex typeNameIndex)
@@ -5455,6 +5871,8 @@ namespace SHVDN
 
             public void Run()
             {
+                _returnCount = 0;
+
                 ulong cGameScriptHandlerAddress = s_getCGameScriptHandlerAddressFunc();
 
                 if (cGameScriptHandlerAddress == 0)
@@ -5462,7 +5880,6 @@ namespace SHVDN
                     return;
                 }
 
-                List<int> handles = new List<int>();
                 CGameScriptResource* firstRegisteredScriptResourceItem = *(CGameScriptResource**)(cGameScriptHandlerAddress + 48);
                 for (CGameScriptResource* item = firstRegisteredScriptResourceItem; item != null; item = item->next)
                 {
@@ -5471,15 +5888,13 @@ namespace SHVDN
                         continue;
                     }
 
-                    handles.Add((int)item->counterOfPool);
-                }
+                    if (_returnCount == _returnHandles.Length)
+                    {
+                        Array.Resize(ref _returnHandles, Math.Max(_returnHandles.Length * 2, 16));
+                    }
 
-                if (handles.Count == 0)
-                {
-                    return;
+                    _returnHandles[_returnCount++] = (int)item->counterOfPool;
                 }
-
-                _returnHandles = handles.ToArray();
             }
         }
 
@@ -5566,15 +5981,50 @@ namespace SHVDN
 
         private static delegate* unmanaged[Stdcall]<ulong> s_getCGameScriptHandlerAddressFunc;
 
+        [ThreadStatic]
+        private static GetAllCScriptResourceHandlesTask s_getCheckpointHandlesTask;
+        private static readonly HandleSetGeneration s_checkpointGeneration = new(CopyCheckpointHandles);
+
         public static int[] GetCheckpointHandles()
         {
-            var task = new GetAllCScriptResourceHandlesTask(CScriptResourceTypeNameIndex.Checkpoint);
+            int[] handles = Array.Empty<int>();
+            int count = CopyCheckpointHandles(ref handles);
+            if (count != handles.Length)
+            {
+                Array.Resize(ref handles, count);
+            }
 
-            ScriptDomain.CurrentDomain.ExecuteTaskWithGameThreadTlsContext(task);
+            return handles;
+        }
+        /// <summary>
+        /// Copies the handles of all checkpoints without allocating if the buffer is big enough.
+        /// </summary>
+        /// <param name="handles">The buffer to store the handles in. Replaced with a bigger one if it is too small.</param>
+        /// <returns>The number of stored handles.</returns>
+        public static int CopyCheckpointHandles(ref int[] handles)
+        {
+            GetAllCScriptResourceHandlesTask task = s_getCheckpointHandlesTask ??= new GetAllCScriptResourceHandlesTask(CScriptResourceTypeNameIndex.Checkpoint);
+            task._returnHandles = handles;
 
-            return task._returnHandles;
+            try
+            {
+                ScriptDomain.CurrentDomain.ExecuteTaskWithGameThreadTlsContext(task);
+                handles = task._returnHandles;
+                return task._returnCount;
+            }
+            finally
+            {
+                // Do not keep the buffer of the caller alive
+                task._returnHandles = null;
+            }
         }
 
+        /// <summary>
+        /// Gets a number that is incremented whenever a checkpoint is created or deleted. The checkpoints are compared
+        /// at most once per frame, so the number stays the same for the rest of the frame.
+        /// </summary>
+        public static int GetCheckpointGeneration() => s_checkpointGeneration.Get(ScriptDomain.CurrentDomain?.FrameCount ?? 0);
+
         public static IntPtr GetCheckpointAddress(int handle)
         {
             var task = new GetCScriptResourceAddressTask(handle, s_checkpointPoolAddress, 0x60);
@@ -5921,6 +6371,72 @@ namespace SHVDN
             return ((FwBasePool*)(*NativeMemory.s_interiorProxyPoolAddress))->GetGuidHandleFromAddress(interiorProxyAddress);
         }
 
+        /// <summary>
+        /// Collects the addresses of all peds and vehicles without creating script handles for them.
+        /// </summary>
+        /// <param name="addresses">The buffer to store the addresses in. Replaced with a bigger one if it is too small.</param>
+        /// <returns>The number of stored addresses.</returns>
+        internal static int CopyPedAndVehicleAddresses(ref ulong[] addresses) => CopyPedAndVehicleAddresses(ref addresses, out _);
+        /// <summary>
+        /// Collects the addresses of all peds and vehicles without creating script handles for them. The peds are stored
+        /// before the vehicles.
+        /// </summary>
+        /// <param name="addresses">The buffer to store the addresses in. Replaced with a bigger one if it is too small.</param>
+        /// <param name="pedCount">The number of stored ped addresses.</param>
+        /// <returns>The number of stored addresses.</returns>
+        internal static int CopyPedAndVehicleAddresses(ref ulong[] addresses, out int pedCount)
+        {
+            var pedPool = s_pedPoolAddress != null ? (FwBasePool*)(*s_pedPoolAddress) : null;
+            RageSysMemPoolAllocator* vehiclePool = s_vehiclePoolAddress != null && *s_vehiclePoolAddress != 0
+                ? *(RageSysMemPoolAllocator**)(*s_vehiclePoolAddress)
+                : null;
+
+            int capacity = (pedPool != null ? (int)pedPool->size : 0) + (vehiclePool != null ? (int)vehiclePool->size : 0);
+            if (addresses.Length < capacity)
+            {
+                addresses = new ulong[capacity];
+            }
+
+            int count = 0;
+            if (pedPool != null)
+            {
+                count = pedPool->CopyAddresses(addresses, count);
+            }
+            pedCount = count;
+            if (vehiclePool != null)
+            {
+                count = vehiclePool->CopyAddresses(addresses, count);
+            }
+
+            return count;
+        }
+
+        /// <summary>
+        /// Gets the position of an entity. Must be called on the main thread of the script domain.
+        /// </summary>
+        internal static FVector3 GetEntityPositionFromAddress(ulong address)
+        {
+            float* position = stackalloc float[4];
+            s_entityPosFunc(address, position);
+            return new FVector3(position[0], position[1], position[2]);
+        }
+
+        /// <summary>
+        /// Creates a script handle for an entity. Must be called on the main thread of the script domain, unlike
+        /// <see cref="GetEntityHandleFromAddress(IntPtr)"/>.
+        /// </summary>
+        /// <returns>The handle, or zero if the script guid pool is (almost) full.</returns>
+        internal static int CreateEntityHandleOnMainThread(ulong address)
+        {
+            if (s_fwScriptGuidPoolAddress == null || *s_fwScriptGuidPoolAddress == 0 ||
+                ((FwScriptGuidPool*)(*s_fwScriptGuidPoolAddress))->IsFull())
+            {
+                return 0;
+            }
+
+            return s_createGuid(address);
+        }
+
         public static int GetEntityHandleFromAddress(IntPtr address)
         {
             var task = new GetEntityHandleTask(address);
@@ -6075,106 +6591,182 @@ namespace SHVDN
             internal uint AttachBoneId;
         }
 
-        private static ItemInfo* FindItemInfoFromWeaponAndAmmoInfoArray(uint nameHash)
+        private struct WeaponIndexEntry
+        {
+            internal ulong ItemInfo;
+            internal bool IsWeaponInfo;
+        }
+
+        private sealed class WeaponIndex
+        {
+            internal ulong ArrayData;
+            internal ushort ArraySize;
+            internal HashIndex<WeaponIndexEntry> Entries;
+            internal uint[] WeaponHashesForHumanPeds;
+        }
+
+        private sealed class WeaponComponentIndex
+        {
+            internal ulong ArrayData;
+            internal uint ArraySize;
+            internal HashIndex<ulong> Entries;
+            internal uint[] ComponentHashes;
+        }
+
+        private static WeaponIndex s_weaponIndex;
+        private static WeaponComponentIndex s_weaponComponentIndex;
+
+        private static WeaponIndex GetWeaponIndex()
         {
             if (s_weaponAndAmmoInfoArrayPtr == null)
             {
                 return null;
             }
 
-            ushort weaponAndAmmoInfoElementCount = s_weaponAndAmmoInfoArrayPtr->size;
+            // The array is reallocated when weapon DLCs are loaded, so the index is valid as long as the array is the same
+            ulong arrayData = (ulong)s_weaponAndAmmoInfoArrayPtr->data;
+            ushort arraySize = s_weaponAndAmmoInfoArrayPtr->size;
 
-            if (weaponAndAmmoInfoElementCount == 0)
+            WeaponIndex index = System.Threading.Volatile.Read(ref s_weaponIndex);
+            if (index != null && index.ArrayData == arrayData && index.ArraySize == arraySize)
             {
-                return null;
+                return index;
             }
 
-            int low = 0, high = weaponAndAmmoInfoElementCount - 1;
-            while (true)
+            lock (s_metadataIndexLock)
             {
-                int indexToRead = (low + high) >> 1;
-                var weaponOrAmmoInfo = (ItemInfo*)s_weaponAndAmmoInfoArrayPtr->GetElementAddress(indexToRead);
-
-                if (weaponOrAmmoInfo->nameHash == nameHash)
-                {
-                    return weaponOrAmmoInfo;
-                }
-
-                // The array is sorted in ascending order
-                if (weaponOrAmmoInfo->nameHash <= nameHash)
+                index = s_weaponIndex;
+                if (index == null || index.ArrayData != arrayData || index.ArraySize != arraySize)
                 {
-                    low = indexToRead + 1;
-                }
-                else
-                {
-                    high = indexToRead - 1;
+                    index = BuildWeaponIndex(arrayData, arraySize);
+                    System.Threading.Volatile.Write(ref s_weaponIndex, index);
                 }
 
-                if (low > high)
-                {
-                    return null;
-                }
+                return index;
             }
         }
 
-        private static ItemInfo* FindWeaponInfo(uint nameHash)
+        private static WeaponIndex BuildWeaponIndex(ulong arrayData, ushort arraySize)
         {
-            ItemInfo* itemInfoPtr = FindItemInfoFromWeaponAndAmmoInfoArray(nameHash);
+            var entries = new List<KeyValuePair<uint, WeaponIndexEntry>>(arraySize);
+            var weaponHashesForHumanPeds = new List<uint>();
 
-            if (itemInfoPtr == null)
+            for (int i = 0; i < arraySize; i++)
             {
-                return null;
+                var weaponOrAmmoInfo = (ItemInfo*)((ulong*)arrayData)[i];
+
+                // Calling the virtual function to get the class name is what makes the lookups expensive, so do it only once per item
+                const uint cWeaponInfoNameHash = 0x861905B4;
+                bool isWeaponInfo = weaponOrAmmoInfo->GetClassNameHash() == cWeaponInfoNameHash;
+
+                entries.Add(new KeyValuePair<uint, WeaponIndexEntry>(weaponOrAmmoInfo->nameHash, new WeaponIndexEntry
+                {
+                    ItemInfo = (ulong)weaponOrAmmoInfo,
+                    IsWeaponInfo = isWeaponInfo,
+                }));
+
+                if (isWeaponInfo && (CanPedEquip(weaponOrAmmoInfo) || s_disallowWeaponHashSetForHumanPedsOnFoot.Contains(weaponOrAmmoInfo->nameHash)))
+                {
+                    weaponHashesForHumanPeds.Add(weaponOrAmmoInfo->nameHash);
+                }
             }
 
-            uint classNameHash = itemInfoPtr->GetClassNameHash();
+            return new WeaponIndex
+            {
+                ArrayData = arrayData,
+                ArraySize = arraySize,
+                Entries = new HashIndex<WeaponIndexEntry>(entries),
+                WeaponHashesForHumanPeds = weaponHashesForHumanPeds.ToArray(),
+            };
 
-            const uint cWeaponInfoNameHash = 0x861905B4;
-            if (classNameHash == cWeaponInfoNameHash)
+            bool CanPedEquip(ItemInfo* weaponInfoAddress)
             {
-                return itemInfoPtr;
+                return weaponInfoAddress->modelHash != 0 && weaponInfoAddress->slot != 0;
             }
-
-            return null;
         }
 
-        private static WeaponComponentInfo* FindWeaponComponentInfo(uint nameHash)
+        private static WeaponComponentIndex GetWeaponComponentIndex()
         {
             ulong* cWeaponComponentArrayFirstPtr = (ulong*)((byte*)s_offsetForCWeaponComponentArrayAddr + 4 + *(int*)s_offsetForCWeaponComponentArrayAddr);
             uint arrayCount = s_weaponComponentArrayCountAddr != null ? *(uint*)s_weaponComponentArrayCountAddr : 0;
-            if (cWeaponComponentArrayFirstPtr == null || arrayCount == 0)
+            if (cWeaponComponentArrayFirstPtr == null)
             {
                 return null;
             }
 
-            int low = 0, high = (int)arrayCount - 1;
-            while (true)
+            ulong arrayData = arrayCount != 0 ? cWeaponComponentArrayFirstPtr[0] : 0;
+            WeaponComponentIndex index = System.Threading.Volatile.Read(ref s_weaponComponentIndex);
+            if (index != null && index.ArrayData == arrayData && index.ArraySize == arrayCount)
             {
-                int indexToRead = (low + high) >> 1;
-                var weaponComponentInfo = (WeaponComponentInfo*)cWeaponComponentArrayFirstPtr[indexToRead];
+                return index;
+            }
 
-                if (weaponComponentInfo->nameHash == nameHash)
+            lock (s_metadataIndexLock)
+            {
+                index = s_weaponComponentIndex;
+                if (index == null || index.ArrayData != arrayData || index.ArraySize != arrayCount)
                 {
-                    return weaponComponentInfo;
-                }
+                    var entries = new List<KeyValuePair<uint, ulong>>((int)arrayCount);
+                    var componentHashes = new uint[arrayCount];
+                    for (uint i = 0; i < arrayCount; i++)
+                    {
+                        ulong cWeaponComponentInfo = cWeaponComponentArrayFirstPtr[i];
+                        componentHashes[i] = ((WeaponComponentInfo*)cWeaponComponentInfo)->nameHash;
+                        entries.Add(new KeyValuePair<uint, ulong>(componentHashes[i], cWeaponComponentInfo));
+                    }
 
-                // The array is sorted in ascending order
-                if (weaponComponentInfo->nameHash <= nameHash)
-                {
-                    low = indexToRead + 1;
-                }
-                else
-                {
-                    high = indexToRead - 1;
+                    index = new WeaponComponentIndex
+                    {
+                        ArrayData = arrayData,
+                        ArraySize = arrayCount,
+                        Entries = new HashIndex<ulong>(entries),
+                        ComponentHashes = componentHashes,
+                    };
+                    System.Threading.Volatile.Write(ref s_weaponComponentIndex, index);
                 }
 
-                if (low > high)
-                {
-                    return null;
-                }
+                return index;
             }
         }
 
+        private static ItemInfo* FindWeaponInfo(uint nameHash)
+        {
+            WeaponIndex index = GetWeaponIndex();
+            if (index == null || !index.Entries.TryGetValue(nameHash, out WeaponIndexEntry entry) || !entry.IsWeaponInfo)
+            {
+                return null;
+            }
+
+            return (ItemInfo*)entry.ItemInfo;
+        }
+
+        private static WeaponComponentInfo* FindWeaponComponentInfo(uint nameHash)
+        {
+            WeaponComponentIndex index = GetWeaponComponentIndex();
+            if (index == null || !index.Entries.TryGetValue(nameHash, out ulong weaponComponentInfo))
+            {
+                return null;
+            }
+
+            return (WeaponComponentInfo*)weaponComponentInfo;
+        }
+
         public static bool IsHashValidAsWeaponHash(uint weaponHash) => FindWeaponInfo(weaponHash) != null;
+        /// <summary>
+        /// Checks if each of the hashes is a valid weapon hash.
+        /// </summary>
+        /// <param name="weaponHashes">The weapon hashes to check.</param>
+        /// <param name="results">The array to store the results in, at the same indices as in <paramref name="weaponHashes"/>.</param>
+        public static void IsHashValidAsWeaponHash(uint[] weaponHashes, bool[] results)
+        {
+            ThrowIfBulkQueryResultsTooShort(weaponHashes.Length, results.Length);
+
+            WeaponIndex index = GetWeaponIndex();
+            for (int i = 0; i < weaponHashes.Length; i++)
+            {
+                results[i] = index != null && index.Entries.TryGetValue(weaponHashes[i], out WeaponIndexEntry entry) && entry.IsWeaponInfo;
+            }
+        }
 
         public static uint GetAttachmentPointHash(uint weaponHash, uint componentHash)
         {
@@ -6214,54 +6806,14 @@ namespace SHVDN
 
         public static List<uint> GetAllWeaponHashesForHumanPeds()
         {
-            if (s_weaponAndAmmoInfoArrayPtr == null)
-            {
-                return new List<uint>();
-            }
-
-            ushort weaponAndAmmoInfoElementCount = s_weaponAndAmmoInfoArrayPtr->size;
-            var resultList = new List<uint>();
-
-            for (int i = 0; i < weaponAndAmmoInfoElementCount; i++)
-            {
-                var weaponOrAmmoInfo = (ItemInfo*)s_weaponAndAmmoInfoArrayPtr->GetElementAddress(i);
-
-                if (!CanPedEquip(weaponOrAmmoInfo) && !s_disallowWeaponHashSetForHumanPedsOnFoot.Contains(weaponOrAmmoInfo->nameHash))
-                {
-                    continue;
-                }
-
-                uint classNameHash = weaponOrAmmoInfo->GetClassNameHash();
-
-                const uint cWeaponInfoNameHash = 0x861905B4;
-                if (classNameHash == cWeaponInfoNameHash)
-                {
-                    resultList.Add(weaponOrAmmoInfo->nameHash);
-                }
-            }
-
-            return resultList;
-
-            bool CanPedEquip(ItemInfo* weaponInfoAddress)
-            {
-                return weaponInfoAddress->modelHash != 0 && weaponInfoAddress->slot != 0;
-            }
+            WeaponIndex index = GetWeaponIndex();
+            return index != null ? new List<uint>(index.WeaponHashesForHumanPeds) : new List<uint>();
         }
 
         public static List<uint> GetAllWeaponComponentHashes()
         {
-            ulong* cWeaponComponentArrayFirstPtr = (ulong*)((byte*)s_offsetForCWeaponComponentArrayAddr + 4 + *(int*)s_offsetForCWeaponComponentArrayAddr);
-            uint arrayCount = s_weaponComponentArrayCountAddr != null ? *(uint*)s_weaponComponentArrayCountAddr : 0;
-            var resultList = new List<uint>();
-
-            for (uint i = 0; i < arrayCount; i++)
-            {
-                ulong cWeaponComponentInfo = cWeaponComponentArrayFirstPtr[i];
-                uint weaponComponentNameHash = *(uint*)(cWeaponComponentInfo + 0x10);
-                resultList.Add(weaponComponentNameHash);
-            }
-
-            return resultList;
+            WeaponComponentIndex index = GetWeaponComponentIndex();
+            return index != null ? new List<uint>(index.ComponentHashes) : new List<uint>();
         }
 
         public static List<uint> GetAllCompatibleWeaponComponentHashes(uint weaponHash)
@@ -6926,6 +7478,87 @@ namespace SHVDN
 
         private static bool IsPedInjured(byte* pedAddress) => *(float*)(pedAddress + 0x280) < *(float*)(pedAddress + Ped.InjuryHealthThresholdOffset);
 
+        /// <summary>
+        /// The type of the value of a <see cref="NmParameter"/>.
+        /// </summary>
+        public enum NmParameterType : byte
+        {
+            Bool,
+            Int,
+            Float,
+            String,
+            Vector3,
+        }
+
+        /// <summary>
+        /// A NaturalMotion message parameter whose name is already stored in unmanaged memory.
+        /// Create the name pointers with <see cref="GetPinnedNmString(string)"/>.
+        /// </summary>
+        public struct NmParameter
+        {
+            public IntPtr Name;
+            public NmParameterType Type;
+            /// <summary>
+            /// The value of a <see cref="NmParameterType.Bool"/> or <see cref="NmParameterType.Int"/> parameter.
+            /// </summary>
+            public int IntValue;
+            /// <summary>
+            /// The value of a <see cref="NmParameterType.Float"/> parameter or the X component of a <see cref="NmParameterType.Vector3"/> one.
+            /// </summary>
+            public float X;
+            public float Y;
+            public float Z;
+            /// <summary>
+            /// The value of a <see cref="NmParameterType.String"/> parameter, which is only copied to unmanaged memory
+            /// while the message is sent.
+            /// </summary>
+            public string StringValue;
+        }
+
+        private static readonly object s_pinnedNmStringLock = new();
+        private static readonly Dictionary<string, IntPtr> s_pinnedNmStrings = new(StringComparer.Ordinal);
+
+        // NM messages are built on the main thread only, so one message buffer is enough for all of them
+        private static ulong s_nmMessageMemory;
+
+        /// <summary>
+        /// Gets a pointer to a null-terminated UTF-8 copy of a NaturalMotion message or parameter name that stays
+        /// valid until the game exits.
+        /// </summary>
+        /// <remarks>
+        /// The copies are shared and never freed, which is fine for the small fixed set of names the Euphoria
+        /// messages use and saves pinning every name again on every send. Do not pass argument values, which can be
+        /// any string a script builds.
+        /// </remarks>
+        public static IntPtr GetPinnedNmString(string str)
+        {
+            if (str == null)
+            {
+                return NullString;
+            }
+
+            lock (s_pinnedNmStringLock)
+            {
+                if (!s_pinnedNmStrings.TryGetValue(str, out IntPtr handle))
+                {
+                    handle = StringMarshal.StringToCoTaskMemUtf8(str);
+                    s_pinnedNmStrings.Add(str, handle);
+                }
+
+                return handle;
+            }
+        }
+
+        private static ulong GetNmMessageMemory()
+        {
+            if (s_nmMessageMemory == 0)
+            {
+                s_nmMessageMemory = (ulong)AllocCoTaskMem(0x1218).ToInt64();
+            }
+
+            return s_nmMessageMemory;
+        }
+
         private static void SetNmParameters(ulong messageMemory, Dictionary<string, (int value, Type type)> boolIntFloatParameters, Dictionary<string, object> stringVector3ArrayParameters)
         {
             if (boolIntFloatParameters != null)
@@ -6972,6 +7605,31 @@ namespace SHVDN
                 }
             }
         }
+        private static void SetNmParameters(ulong messageMemory, NmParameter[] parameters, IntPtr[] stringValues, int parameterCount)
+        {
+            for (int i = 0; i < parameterCount; i++)
+            {
+                ref NmParameter parameter = ref parameters[i];
+                switch (parameter.Type)
+                {
+                    case NmParameterType.Bool:
+                        s_setNmParameterBool(messageMemory, parameter.Name, parameter.IntValue != 0);
+                        break;
+                    case NmParameterType.Int:
+                        s_setNmParameterInt(messageMemory, parameter.Name, parameter.IntValue);
+                        break;
+                    case NmParameterType.Float:
+                        s_setNmParameterFloat(messageMemory, parameter.Name, parameter.X);
+                        break;
+                    case NmParameterType.String:
+                        s_setNmParameterString(messageMemory, parameter.Name, stringValues[i] != IntPtr.Zero ? stringValues[i] : NullString);
+                        break;
+                    case NmParameterType.Vector3:
+                        s_setNmParameterVector(messageMemory, parameter.Name, parameter.X, parameter.Y, parameter.Z);
+                        break;
+                }
+            }
+        }
 
         internal sealed class NmMessageTask : IScriptTask
         {
@@ -7005,7 +7663,7 @@ namespace SHVDN
                     return;
                 }
 
-                ulong messageMemory = (ulong)AllocCoTaskMem(0x1218).ToInt64();
+                ulong messageMemory = GetNmMessageMemory();
                 if (messageMemory == 0)
                 {
                     return;
@@ -7018,16 +7676,199 @@ namespace SHVDN
                 ulong fragInstNmGtaAddress = *(ulong*)(pedAddress + s_fragInstNmGtaOffset);
                 IntPtr messageStringPtr = ScriptDomain.CurrentDomain.PinString(_messageName);
                 s_sendNmMessageToPedFunc((ulong)fragInstNmGtaAddress, messageStringPtr, messageMemory);
+            }
+        }
 
-                FreeCoTaskMem(new IntPtr((long)messageMemory));
+        /// <summary>
+        /// Sends one NM message to a list of peds in a single task, optionally preparing their ragdoll first the
+        /// same way <c>GTA.NaturalMotion.Message.SendTo</c> does.
+        /// </summary>
+        internal sealed class NmMessageBatchTask : IScriptTask
+        {
+            #region Fields
+            internal int[] _targetHandles;
+            internal int _targetCount;
+            internal IntPtr _messageName;
+            internal NmParameter[] _parameters;
+            internal int _parameterCount;
+            internal bool _prepareRagdoll;
+            internal bool _restartRagdoll;
+            internal int _ragdollDuration;
+            private IntPtr[] _stringValues = Array.Empty<IntPtr>();
+            #endregion
+
+            public void Run()
+            {
+                ulong messageMemory = GetNmMessageMemory();
+                if (messageMemory == 0)
+                {
+                    return;
+                }
+
+                PinStringValues();
+                try
+                {
+                    SendToTargets(messageMemory);
+                }
+                finally
+                {
+                    FreeStringValues();
+                }
+            }
+
+            private void SendToTargets(ulong messageMemory)
+            {
+                for (int i = 0; i < _targetCount; i++)
+                {
+                    int handle = _targetHandles[i];
+                    IntPtr pedAddress = GetEntityAddress(handle);
+                    if (pedAddress == IntPtr.Zero)
+                    {
+                        continue;
+                    }
+
+                    if (_prepareRagdoll)
+                    {
+                        PrepareRagdoll(handle, pedAddress);
+                    }
+
+                    if (!IsTaskNmScriptControlOrEventSwitch2NmActive(pedAddress))
+                    {
+                        continue;
+                    }
+
+                    // Build the message again for every ped instead of relying on the game to leave the sent message untouched
+                    s_initMessageMemoryFunc(messageMemory, messageMemory + 0x18, 0x40);
+                    SetNmParameters(messageMemory, _parameters, _stringValues, _parameterCount);
+
+                    ulong fragInstNmGtaAddress = *(ulong*)((byte*)pedAddress + s_fragInstNmGtaOffset);
+                    s_sendNmMessageToPedFunc(fragInstNmGtaAddress, _messageName, messageMemory);
+                }
+            }
+
+            private void PinStringValues()
+            {
+                if (_stringValues.Length < _parameterCount)
+                {
+                    _stringValues = new IntPtr[_parameterCount];
+                }
+
+                for (int i = 0; i < _parameterCount; i++)
+                {
+                    ref NmParameter parameter = ref _parameters[i];
+                    _stringValues[i] = parameter.Type == NmParameterType.String && parameter.StringValue != null
+                        ? StringMarshal.StringToCoTaskMemUtf8(parameter.StringValue)
+                        : IntPtr.Zero;
+                }
+            }
+
+            private void FreeStringValues()
+            {
+                for (int i = 0; i < _parameterCount; i++)
+                {
+                    if (_stringValues[i] != IntPtr.Zero)
+                    {
+                        Marshal.FreeCoTaskMem(_stringValues[i]);
+                        _stringValues[i] = IntPtr.Zero;
+                    }
+                }
+            }
+
+            private void PrepareRagdoll(int handle, IntPtr pedAddress)
+            {
+                if (_restartRagdoll)
+                {
+                    EnsurePedCanRagdoll(handle);
+                    // Always call to specify the new duration
+                    SetPedToRagdoll(handle, _ragdollDuration);
+                }
+                else if (!IsPedRagdoll(handle))
+                {
+                    EnsurePedCanRagdoll(handle);
+                }
+
+                if (!IsTaskNmScriptControlOrEventSwitch2NmActive(pedAddress))
+                {
+                    // Does not call when a CTaskNMControl task is active or the CEvent related to CTaskNMControl occured, just like in legacy scripts.
+                    // Otherwise, the ragdoll duration will be overridden.
+                    SetPedToRagdoll(handle, -1);
+                }
+            }
+
+            private static bool IsPedRagdoll(int handle)
+            {
+                ulong arg = (ulong)handle;
+                return *(int*)NativeFunc.InvokeInternal(0x47E4E977581C5B55 /* IS_PED_RAGDOLL */, &arg, 1) != 0;
+            }
+
+            private static void EnsurePedCanRagdoll(int handle)
+            {
+                ulong* args = stackalloc ulong[2] { (ulong)handle, 1 };
+                if (*(int*)NativeFunc.InvokeInternal(0x128F79EDCECE4FD5 /* CAN_PED_RAGDOLL */, args, 1) == 0)
+                {
+                    NativeFunc.InvokeInternal(0xB128377056A54E2A /* SET_PED_CAN_RAGDOLL */, args, 2);
+                }
+            }
+
+            private static void SetPedToRagdoll(int handle, int duration)
+            {
+                ulong* args = stackalloc ulong[7] { (ulong)handle, 10000, (ulong)duration, 1, 1, 1, 0 };
+                NativeFunc.InvokeInternal(0xAE99FB955581844A /* SET_PED_TO_RAGDOLL */, args, 7);
             }
         }
 
+        [ThreadStatic]
+        private static NmMessageBatchTask s_nmMessageBatchTask;
+
         public static void SendNmMessage(int targetHandle, string messageName, Dictionary<string, (int value, Type type)> boolIntFloatParameters, Dictionary<string, object> stringVector3ArrayParameters)
         {
             var task = new NmMessageTask(targetHandle, messageName, boolIntFloatParameters, stringVector3ArrayParameters);
             ScriptDomain.CurrentDomain.ExecuteTaskWithGameThreadTlsContext(task);
         }
+        /// <summary>
+        /// Sends a NM message to multiple peds with a single switch to the main thread.
+        /// </summary>
+        /// <param name="targetHandles">The handles of the peds to send the message to.</param>
+        /// <param name="targetCount">The number of handles in <paramref name="targetHandles"/> to use.</param>
+        /// <param name="messageName">The message name returned by <see cref="GetPinnedNmString(string)"/>.</param>
+        /// <param name="parameters">The message parameters.</param>
+        /// <param name="parameterCount">The number of parameters in <paramref name="parameters"/> to use.</param>
+        /// <param name="prepareRagdoll">
+        /// <see langword="true" /> to let the peds ragdoll and start a NM task on the ones that do not run one yet.
+        /// </param>
+        /// <param name="restartRagdoll">
+        /// <see langword="true" /> to always start a new ragdoll task for <paramref name="ragdollDuration"/> milliseconds.
+        /// Only used if <paramref name="prepareRagdoll"/> is <see langword="true" />.
+        /// </param>
+        /// <param name="ragdollDuration">How long the new ragdoll task will last (-1 for looped).</param>
+        public static void SendNmMessage(int[] targetHandles, int targetCount, IntPtr messageName, NmParameter[] parameters, int parameterCount, bool prepareRagdoll, bool restartRagdoll, int ragdollDuration)
+        {
+            if (targetCount == 0)
+            {
+                return;
+            }
+
+            // Reuse one task object per calling thread, since the task always runs before this method returns
+            NmMessageBatchTask task = s_nmMessageBatchTask ??= new NmMessageBatchTask();
+            task._targetHandles = targetHandles;
+            task._targetCount = targetCount;
+            task._messageName = messageName;
+            task._parameters = parameters;
+            task._parameterCount = parameterCount;
+            task._prepareRagdoll = prepareRagdoll;
+            task._restartRagdoll = restartRagdoll;
+            task._ragdollDuration = ragdollDuration;
+
+            try
+            {
+                ScriptDomain.CurrentDomain.ExecuteTaskWithGameThreadTlsContext(task);
+            }
+            finally
+            {
+                task._targetHandles = null;
+                task._parameters = null;
+            }
+        }
 
         #endregion
     }
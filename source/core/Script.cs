@@ -16,6 +16,9 @@ namespace SHVDN
         internal SemaphoreSlim _waitEvent;
         internal SemaphoreSlim _continueEvent;
         internal readonly ConcurrentQueue<Tuple<bool, KeyEventArgs>> _keyboardEvents = new();
+        private readonly ConcurrentQueue<StreamingCompletion> _streamingCompletions = new();
+        private NativeCallBatch _deferredNativeCalls;
+        private volatile bool _hasPendingApply;
 
         private Thread _thread; // The thread hosting the execution of the script
 
@@ -32,6 +35,9 @@ namespace SHVDN
         private readonly ReaderWriterLockSlim _rwLock = new ();
 
         private readonly CheapThreadSafeStopwatch _stopwatch = new();
+        private readonly ScriptMetrics _metrics = new();
+        // Replaced as a whole on change, so messages can be delivered without taking a lock or copying the list
+        private ScriptMessageSubscription[] _messageSubscriptions = Array.Empty<ScriptMessageSubscription>();
 
         public void Dispose()
         {
@@ -96,6 +102,62 @@ namespace SHVDN
 
         internal CheapThreadSafeStopwatch StopwatchForTimeout => _stopwatch;
 
+        internal ScriptMetrics Metrics => _metrics;
+
+        internal ScriptMessageSubscription[] MessageSubscriptions => Volatile.Read(ref _messageSubscriptions);
+
+        internal void AddMessageSubscription(ScriptMessageSubscription subscription)
+        {
+            ScriptMessageSubscription[] current, updated;
+            do
+            {
+                current = Volatile.Read(ref _messageSubscriptions);
+                updated = new ScriptMessageSubscription[current.Length + 1];
+                Array.Copy(current, updated, current.Length);
+                updated[current.Length] = subscription;
+            }
+            while (Interlocked.CompareExchange(ref _messageSubscriptions, updated, current) != current);
+        }
+        internal void RemoveMessageSubscription(ScriptMessageSubscription subscription)
+        {
+            ScriptMessageSubscription[] current, updated;
+            do
+            {
+                current = Volatile.Read(ref _messageSubscriptions);
+                int index = Array.IndexOf(current, subscription);
+                if (index < 0)
+                {
+                    return;
+                }
+
+                updated = new ScriptMessageSubscription[current.Length - 1];
+                Array.Copy(current, 0, updated, 0, index);
+                Array.Copy(current, index + 1, updated, index, updated.Length - index);
+            }
+            while (Interlocked.CompareExchange(ref _messageSubscriptions, updated, current) != current);
+        }
+
+        internal void EnqueueStreamingCompletion(StreamingCompletion completion)
+        {
+            _streamingCompletions.Enqueue(completion);
+        }
+
+        internal bool HasComputeHandler => Compute != null;
+        internal NativeCallBatch DeferredNativeCalls => _deferredNativeCalls ??= new NativeCallBatch();
+        /// <summary>
+        /// Gets or sets whether the compute phase ran for this script and <see cref="Apply"/> is yet to be raised.
+        /// </summary>
+        internal bool HasPendingApply
+        {
+            get => _hasPendingApply;
+            set => _hasPendingApply = value;
+        }
+
+        internal void RaiseCompute(in FrameSnapshot snapshot, NativeCallBatch deferredCalls)
+        {
+            Compute?.Invoke(in snapshot, deferredCalls);
+        }
+
         private Thread Thread
         {
             get
@@ -228,6 +290,11 @@ namespace SHVDN
         /// </summary>
         public bool IsUsingThread => _thread != null;
 
+        /// <summary>
+        /// Gets a snapshot of the execution metrics of this script, such as the tick times and the allocated bytes.
+        /// </summary>
+        public ScriptMetricsSnapshot GetMetrics() => _metrics.GetSnapshot(Name, Filename);
+
         /// <summary>
         /// An event that is raised every tick of the script.
         /// </summary>
@@ -236,6 +303,23 @@ namespace SHVDN
         /// An event that is raised when this script gets aborted for any reason.
         /// </summary>
         public event EventHandler Aborted;
+        /// <summary>
+        /// An event that is raised right before this script yields the execution back to the script domain, which
+        /// happens when a tick ends or when <see cref="Wait(int)"/> is called.
+        /// Use this to submit work that is deferred during a tick but has to reach the game in the same frame.
+        /// </summary>
+        public event EventHandler Yielding;
+        /// <summary>
+        /// An event that is raised at the start of every frame on a worker thread, in parallel with the compute handlers
+        /// of other scripts. Handlers must not call script functions and should only read the snapshot they are given;
+        /// the script functions to call have to be added to the given batch instead.
+        /// </summary>
+        public event ScriptComputeHandler Compute;
+        /// <summary>
+        /// An event that is raised at the start of the next tick after the script functions added during
+        /// <see cref="Compute"/> have been called on the main thread.
+        /// </summary>
+        public event EventHandler Apply;
 
         /// <summary>
         /// An event that is raised when a key is lifted.
@@ -378,6 +462,7 @@ namespace SHVDN
             {
                 // Wait for script domain to continue this script
                 _continueEvent.Wait();
+                _metrics.BeginSlice();
 
                 while (IsRunning)
                 {
@@ -420,6 +505,62 @@ namespace SHVDN
                 }
             }
 
+            // Deliver messages of the channels this script subscribes to
+            foreach (ScriptMessageSubscription subscription in MessageSubscriptions)
+            {
+                try
+                {
+                    subscription.Deliver();
+                }
+                catch (ThreadAbortException)
+                {
+                    // Stop main loop immediately on a thread abort exception
+                    throw;
+                }
+                catch (Exception ex)
+                {
+                    // The rest of the batch of this subscription is dropped, but continue to run script
+                    ScriptDomain.HandleUnhandledException(this, new UnhandledExceptionEventArgs(ex, false));
+                }
+            }
+
+            // Run the callbacks of the streaming requests that completed since the last tick
+            while (_streamingCompletions.TryDequeue(out StreamingCompletion completion))
+            {
+                try
+                {
+                    completion.Invoke();
+                }
+                catch (ThreadAbortException)
+                {
+                    // Stop main loop immediately on a thread abort exception
+                    throw;
+                }
+                catch (Exception ex)
+                {
+                    ScriptDomain.HandleUnhandledException(this, new UnhandledExceptionEventArgs(ex, false));
+                }
+            }
+
+            if (_hasPendingApply)
+            {
+                _hasPendingApply = false;
+
+                try
+                {
+                    Apply?.Invoke(this, EventArgs.Empty);
+                }
+                catch (ThreadAbortException)
+                {
+                    // Stop main loop immediately on a thread abort exception
+                    throw;
+                }
+                catch (Exception ex)
+                {
+                    ScriptDomain.HandleUnhandledException(this, new UnhandledExceptionEventArgs(ex, false));
+                }
+            }
+
             try
             {
                 Tick?.Invoke(this, EventArgs.Empty);
@@ -435,6 +576,35 @@ namespace SHVDN
 
                 // An exception during tick is fatal, so abort the script and stop main loop
                 Abort();
+                return;
+            }
+
+            // Scripts with dedicated threads raise this in `Wait`, which the main loop calls right after the tick
+            if (!IsUsingThread)
+            {
+                RaiseYielding();
+            }
+        }
+
+        private void RaiseYielding()
+        {
+            EventHandler handler = Yielding;
+            if (handler == null)
+            {
+                return;
+            }
+
+            try
+            {
+                handler(this, EventArgs.Empty);
+            }
+            catch (ThreadAbortException)
+            {
+                throw;
+            }
+            catch (Exception ex)
+            {
+                ScriptDomain.HandleUnhandledException(this, new UnhandledExceptionEventArgs(ex, false));
             }
         }
 
@@ -487,6 +657,9 @@ namespace SHVDN
                 ScriptDomain.HandleUnhandledException(this, new UnhandledExceptionEventArgs(ex, true));
             }
 
+            ScriptDomain.CurrentDomain?.MessageBus.OnScriptAborted(this);
+            ScriptDomain.CurrentDomain?.StreamingRequests.OnScriptAborted(this);
+
             if (IsUsingThread)
             {
                 _waitEvent.Release();
@@ -537,13 +710,20 @@ namespace SHVDN
         {
             if (IsUsingThread)
             {
+                if (IsRunning)
+                {
+                    RaiseYielding();
+                }
+
                 Stopwatch sw = new Stopwatch();
                 sw.Start();
 
                 do
                 {
+                    _metrics.EndSlice();
                     _waitEvent.Release();
                     _continueEvent.Wait();
+                    _metrics.BeginSlice();
                 }
                 while (sw.ElapsedMilliseconds < ms);
             }
@@ -0,0 +1,432 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Security.Cryptography;
+using System.Text;
+using System.Threading;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// A content-addressed shadow copy cache for script assemblies.
+    /// </summary>
+    /// <remarks>
+    /// Assemblies are loaded from copies stored by the hash of their content, so the original files in the scripts
+    /// directory are never locked and can be updated while the game is running. Copies of unchanged files are reused
+    /// across reloads. The hash and whether the file is a managed assembly are remembered in an index keyed by the
+    /// file path, size and last write time, so unchanged files are neither hashed nor inspected again.
+    /// The index is only written by the game install that owns the cache directory, see
+    /// <see cref="GetDefaultCacheDirectory"/>.
+    /// </remarks>
+    internal sealed class ScriptAssemblyCache
+    {
+        private sealed class Entry
+        {
+            internal long _length;
+            internal long _lastWriteTimeUtcTicks;
+            internal long _pdbLastWriteTimeUtcTicks;
+            internal string _contentHash;
+            // -1 if not inspected yet
+            internal int _isManagedAssembly = -1;
+        }
+
+        private const string IndexFileName = "index.txt";
+        private const int IndexVersion = 1;
+
+        private readonly object _lock = new();
+        private readonly string _cacheDirectory;
+        private readonly Dictionary<string, Entry> _entries = new(StringComparer.OrdinalIgnoreCase);
+        private bool _isIndexDirty;
+
+        internal ScriptAssemblyCache(string cacheDirectory)
+        {
+            _cacheDirectory = cacheDirectory;
+            LoadIndex();
+        }
+
+        /// <summary>
+        /// Gets the default directory of the cache for a scripts directory. Each game install gets its own directory,
+        /// so game instances of other installs never overwrite its index or delete its copies.
+        /// </summary>
+        /// <param name="scriptDirectory">The full path of the scripts directory.</param>
+        internal static string GetDefaultCacheDirectory(string scriptDirectory)
+        {
+            string normalizedPath = Path.GetFullPath(scriptDirectory).TrimEnd(Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar).ToUpperInvariant();
+            return Path.Combine(Path.GetTempPath(), "ScriptHookVDotNet", "AssemblyCache", ComputeStringHash(normalizedPath));
+        }
+
+        /// <summary>
+        /// Checks if the file is a managed assembly, reusing the result of the last inspection if the file is unchanged.
+        /// Can be called from multiple threads at once.
+        /// </summary>
+        /// <param name="fileName">The full path of the file to check.</param>
+        /// <param name="inspect">The function that inspects the file if there is no cached result.</param>
+        internal bool IsManagedAssembly(string fileName, Func<string, bool> inspect)
+        {
+            Entry entry = GetCurrentEntry(fileName);
+            if (entry == null)
+            {
+                return false;
+            }
+
+            int isManagedAssembly = Volatile.Read(ref entry._isManagedAssembly);
+            if (isManagedAssembly < 0)
+            {
+                // Inspect outside of the lock so other files can be checked in parallel
+                isManagedAssembly = inspect(fileName) ? 1 : 0;
+
+                lock (_lock)
+                {
+                    entry._isManagedAssembly = isManagedAssembly;
+                    _isIndexDirty = true;
+                }
+            }
+
+            return isManagedAssembly != 0;
+        }
+
+        /// <summary>
+        /// Gets the path of the shadow copy of an assembly, creating the copy if no copy with the same content exists.
+        /// The debug symbols are copied along with the assembly if present. Can be called from multiple threads at once.
+        /// </summary>
+        /// <param name="fileName">The full path of the assembly.</param>
+        /// <returns>The path of the shadow copy, or <paramref name="fileName"/> if the copy could not be created.</returns>
+        internal string GetShadowCopyPath(string fileName)
+        {
+            try
+            {
+                Entry entry = GetCurrentEntry(fileName);
+                if (entry == null)
+                {
+                    return fileName;
+                }
+
+                string pdbFileName = Path.ChangeExtension(fileName, ".pdb");
+                bool hasPdb = entry._pdbLastWriteTimeUtcTicks != 0;
+
+                string contentHash = Volatile.Read(ref entry._contentHash);
+                if (contentHash == null)
+                {
+                    contentHash = ComputeContentHash(fileName, hasPdb ? pdbFileName : null);
+
+                    lock (_lock)
+                    {
+                        entry._contentHash = contentHash;
+                        _isIndexDirty = true;
+                    }
+                }
+
+                string entryDirectory = Path.Combine(_cacheDirectory, contentHash);
+                string copyFileName = Path.Combine(entryDirectory, Path.GetFileName(fileName));
+                if (File.Exists(copyFileName))
+                {
+                    return copyFileName;
+                }
+
+                Directory.CreateDirectory(entryDirectory);
+                if (hasPdb)
+                {
+                    CopyAtomically(pdbFileName, Path.Combine(entryDirectory, Path.GetFileName(pdbFileName)));
+                }
+                // Copy the assembly last, its existence marks the entry as complete
+                CopyAtomically(fileName, copyFileName);
+
+                return copyFileName;
+            }
+            catch (Exception ex) when (ex is IOException || ex is UnauthorizedAccessException)
+            {
+                Log.Message(Log.Level.Warning, "Failed to shadow copy ", Path.GetFileName(fileName), ", loading the original file instead: ", ex.Message);
+                return fileName;
+            }
+        }
+
+        /// <summary>
+        /// Saves the index and deletes the copies that no file in the index refers to anymore.
+        /// Copies that are still in use (e.g. by another game instance) are left alone and deleted on a later run.
+        /// </summary>
+        /// <param name="loadStartTimeUtc">
+        /// The time the current load started. Copies created after it are kept, since they may belong to a load that
+        /// has not indexed them yet.
+        /// </param>
+        internal void CollectGarbage(DateTime loadStartTimeUtc)
+        {
+            lock (_lock)
+            {
+                var referencedHashes = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+                var removedFiles = new List<string>();
+                foreach (KeyValuePair<string, Entry> entry in _entries)
+                {
+                    if (!File.Exists(entry.Key))
+                    {
+                        removedFiles.Add(entry.Key);
+                        continue;
+                    }
+
+                    if (entry.Value._contentHash != null)
+                    {
+                        referencedHashes.Add(entry.Value._contentHash);
+                    }
+                }
+                foreach (string fileName in removedFiles)
+                {
+                    _entries.Remove(fileName);
+                    _isIndexDirty = true;
+                }
+
+                SaveIndex();
+
+                if (!Directory.Exists(_cacheDirectory))
+                {
+                    return;
+                }
+
+                int deletedCount = 0;
+                foreach (string entryDirectory in Directory.GetDirectories(_cacheDirectory))
+                {
+                    if (referencedHashes.Contains(Path.GetFileName(entryDirectory)) ||
+                        Directory.GetCreationTimeUtc(entryDirectory) >= loadStartTimeUtc)
+                    {
+                        continue;
+                    }
+
+                    if (TryDeleteEntryDirectory(entryDirectory))
+                    {
+                        deletedCount++;
+                    }
+                }
+
+                if (deletedCount > 0)
+                {
+                    Log.Message(Log.Level.Debug, "Deleted ", deletedCount.ToString(), " stale shadow copies from ", _cacheDirectory, ".");
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the index entry of a file, replacing it if the file has changed since it was recorded.
+        /// </summary>
+        /// <returns>The entry, or <see langword="null" /> if the file does not exist.</returns>
+        private Entry GetCurrentEntry(string fileName)
+        {
+            var fileInfo = new FileInfo(fileName);
+            if (!fileInfo.Exists)
+            {
+                return null;
+            }
+
+            var pdbFileInfo = new FileInfo(Path.ChangeExtension(fileName, ".pdb"));
+            long pdbLastWriteTimeUtcTicks = pdbFileInfo.Exists ? pdbFileInfo.LastWriteTimeUtc.Ticks : 0;
+
+            long length = fileInfo.Length;
+            long lastWriteTimeUtcTicks = fileInfo.LastWriteTimeUtc.Ticks;
+
+            lock (_lock)
+            {
+                if (_entries.TryGetValue(fileName, out Entry entry)
+                    && entry._length == length
+                    && entry._lastWriteTimeUtcTicks == lastWriteTimeUtcTicks
+                    && entry._pdbLastWriteTimeUtcTicks == pdbLastWriteTimeUtcTicks)
+                {
+                    return entry;
+                }
+
+                entry = new Entry
+                {
+                    _length = length,
+                    _lastWriteTimeUtcTicks = lastWriteTimeUtcTicks,
+                    _pdbLastWriteTimeUtcTicks = pdbLastWriteTimeUtcTicks,
+                };
+                _entries[fileName] = entry;
+                _isIndexDirty = true;
+
+                return entry;
+            }
+        }
+
+        /// <summary>
+        /// Deletes a copy, starting with the assemblies, so a copy that is still loaded somewhere is left complete
+        /// instead of losing its debug symbols before the locked assembly stops the deletion.
+        /// </summary>
+        private static bool TryDeleteEntryDirectory(string entryDirectory)
+        {
+            try
+            {
+                foreach (string fileName in Directory.GetFiles(entryDirectory))
+                {
+                    if (!string.Equals(Path.GetExtension(fileName), ".pdb", StringComparison.OrdinalIgnoreCase))
+                    {
+                        File.Delete(fileName);
+                    }
+                }
+
+                Directory.Delete(entryDirectory, true);
+                return true;
+            }
+            catch (Exception ex) when (ex is IOException || ex is UnauthorizedAccessException)
+            {
+                // Still loaded somewhere
+                return false;
+            }
+        }
+
+        private static string ComputeStringHash(string value)
+        {
+            using (SHA256 sha256 = SHA256.Create())
+            {
+                return ToHexString(sha256.ComputeHash(Encoding.UTF8.GetBytes(value)), 8);
+            }
+        }
+        private static string ToHexString(byte[] hash, int byteCount)
+        {
+            var hashString = new StringBuilder(byteCount * 2);
+            for (int i = 0; i < byteCount; i++)
+            {
+                hashString.Append(hash[i].ToString("x2", CultureInfo.InvariantCulture));
+            }
+            return hashString.ToString();
+        }
+
+        private static string ComputeContentHash(string fileName, string pdbFileName)
+        {
+            using (SHA256 sha256 = SHA256.Create())
+            {
+                byte[] buffer = new byte[81920];
+                AppendFileToHash(sha256, fileName, buffer);
+                if (pdbFileName != null)
+                {
+                    AppendFileToHash(sha256, pdbFileName, buffer);
+                }
+                sha256.TransformFinalBlock(buffer, 0, 0);
+
+                // Half of the hash is plenty to tell the files apart, and keeps the paths short
+                return ToHexString(sha256.Hash, 16);
+            }
+        }
+        private static void AppendFileToHash(HashAlgorithm hashAlgorithm, string fileName, byte[] buffer)
+        {
+            using (var stream = new FileStream(fileName, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete, buffer.Length, FileOptions.SequentialScan))
+            {
+                int readCount;
+                while ((readCount = stream.Read(buffer, 0, buffer.Length)) > 0)
+                {
+                    hashAlgorithm.TransformBlock(buffer, 0, readCount, null, 0);
+                }
+            }
+        }
+
+        private static void CopyAtomically(string sourceFileName, string destFileName)
+        {
+            if (File.Exists(destFileName))
+            {
+                return;
+            }
+
+            // Copy to a temporary name first, so an interrupted copy is never mistaken for a complete one
+            string tempFileName = destFileName + "." + Guid.NewGuid().ToString("N") + ".tmp";
+            File.Copy(sourceFileName, tempFileName);
+            try
+            {
+                File.Move(tempFileName, destFileName);
+            }
+            catch (IOException) when (File.Exists(destFileName))
+            {
+                // Another game instance created the same copy in the meantime
+                File.Delete(tempFileName);
+            }
+        }
+
+        private void LoadIndex()
+        {
+            string indexFileName = Path.Combine(_cacheDirectory, IndexFileName);
+            if (!File.Exists(indexFileName))
+            {
+                return;
+            }
+
+            try
+            {
+                string[] lines = File.ReadAllLines(indexFileName);
+                if (lines.Length == 0 || lines[0] != IndexVersion.ToString(CultureInfo.InvariantCulture))
+                {
+                    return;
+                }
+
+                for (int i = 1; i < lines.Length; i++)
+                {
+                    string[] fields = lines[i].Split('\t');
+                    if (fields.Length != 6
+                        || !long.TryParse(fields[1], NumberStyles.Integer, CultureInfo.InvariantCulture, out long length)
+                        || !long.TryParse(fields[2], NumberStyles.Integer, CultureInfo.InvariantCulture, out long lastWriteTimeUtcTicks)
+                        || !long.TryParse(fields[3], NumberStyles.Integer, CultureInfo.InvariantCulture, out long pdbLastWriteTimeUtcTicks)
+                        || !int.TryParse(fields[5], NumberStyles.Integer, CultureInfo.InvariantCulture, out int isManagedAssembly))
+                    {
+                        continue;
+                    }
+
+                    _entries[fields[0]] = new Entry
+                    {
+                        _length = length,
+                        _lastWriteTimeUtcTicks = lastWriteTimeUtcTicks,
+                        _pdbLastWriteTimeUtcTicks = pdbLastWriteTimeUtcTicks,
+                        _contentHash = fields[4].Length != 0 ? fields[4] : null,
+                        _isManagedAssembly = isManagedAssembly,
+                    };
+                }
+            }
+            catch (Exception ex) when (ex is IOException || ex is UnauthorizedAccessException)
+            {
+                Log.Message(Log.Level.Warning, "Failed to read the shadow copy index, all script assemblies will be inspected again: ", ex.Message);
+                _entries.Clear();
+            }
+        }
+
+        private void SaveIndex()
+        {
+            if (!_isIndexDirty)
+            {
+                return;
+            }
+
+            var index = new StringBuilder();
+            index.AppendLine(IndexVersion.ToString(CultureInfo.InvariantCulture));
+            foreach (KeyValuePair<string, Entry> entry in _entries)
+            {
+                index.Append(entry.Key).Append('\t')
+                    .Append(entry.Value._length.ToString(CultureInfo.InvariantCulture)).Append('\t')
+                    .Append(entry.Value._lastWriteTimeUtcTicks.ToString(CultureInfo.InvariantCulture)).Append('\t')
+                    .Append(entry.Value._pdbLastWriteTimeUtcTicks.ToString(CultureInfo.InvariantCulture)).Append('\t')
+                    .Append(entry.Value._contentHash ?? string.Empty).Append('\t')
+                    .Append(entry.Value._isManagedAssembly.ToString(CultureInfo.InvariantCulture)).AppendLine();
+            }
+
+            try
+            {
+                Directory.CreateDirectory(_cacheDirectory);
+
+                string indexFileName = Path.Combine(_cacheDirectory, IndexFileName);
+                string tempFileName = indexFileName + ".tmp";
+                File.WriteAllText(tempFileName, index.ToString());
+                if (File.Exists(indexFileName))
+                {
+                    File.Replace(tempFileName, indexFileName, null);
+                }
+                else
+                {
+                    File.Move(tempFileName, indexFileName);
+                }
+
+                _isIndexDirty = false;
+            }
+            catch (Exception ex) when (ex is IOException || ex is UnauthorizedAccessException)
+            {
+                Log.Message(Log.Level.Warning, "Failed to save the shadow copy index: ", ex.Message);
+            }
+        }
+    }
+}
@@ -0,0 +1,502 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Text;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// The metadata of a script assembly that is read straight from the file without loading it.
+    /// </summary>
+    /// <remarks>
+    /// Only the tables needed to find the assembly identity, its references and the script types are read
+    /// (see ECMA-335 partition II, chapters 24 and 25). This is cheap and has no side effects on the script domain,
+    /// so unlike <see cref="Assembly.LoadFrom(string)"/> it can be done for all files in parallel.
+    /// </remarks>
+    internal sealed class ScriptAssemblyMetadata
+    {
+        #region Table Numbers
+        private const int ModuleTable = 0x00;
+        private const int TypeRefTable = 0x01;
+        private const int TypeDefTable = 0x02;
+        private const int FieldTable = 0x04;
+        private const int MethodDefTable = 0x06;
+        private const int ParamTable = 0x08;
+        private const int InterfaceImplTable = 0x09;
+        private const int MemberRefTable = 0x0A;
+        private const int DeclSecurityTable = 0x0E;
+        private const int StandAloneSigTable = 0x11;
+        private const int EventTable = 0x14;
+        private const int PropertyTable = 0x17;
+        private const int ModuleRefTable = 0x1A;
+        private const int TypeSpecTable = 0x1B;
+        private const int AssemblyTable = 0x20;
+        private const int AssemblyRefTable = 0x23;
+        private const int FileTable = 0x26;
+        private const int ExportedTypeTable = 0x27;
+        private const int ManifestResourceTable = 0x28;
+        private const int GenericParamTable = 0x2A;
+        private const int MethodSpecTable = 0x2B;
+        private const int GenericParamConstraintTable = 0x2C;
+        #endregion
+
+        private enum BaseTypeKind
+        {
+            None,
+            Script,
+            Unknown,
+        }
+
+        private ScriptAssemblyMetadata()
+        {
+        }
+
+        /// <summary>
+        /// Gets the simple name of the assembly.
+        /// </summary>
+        internal string Name { get; private set; }
+        /// <summary>
+        /// Gets the version of the assembly.
+        /// </summary>
+        internal Version Version { get; private set; }
+        /// <summary>
+        /// Gets the names and versions of the assemblies the assembly references.
+        /// </summary>
+        internal AssemblyName[] ReferencedAssemblies { get; private set; }
+        /// <summary>
+        /// Gets whether the assembly references any scripting API assembly.
+        /// </summary>
+        internal bool ReferencesScriptingApi { get; private set; }
+        /// <summary>
+        /// Gets the number of types that derive from <c>GTA.Script</c>, or from a type in another assembly that is not
+        /// part of the framework and thus may derive from <c>GTA.Script</c> as well.
+        /// Types are only found with reflection after loading the assembly, this count is an upper bound for them.
+        /// </summary>
+        internal int PossibleScriptTypeCount { get; private set; }
+
+        /// <summary>
+        /// Reads the metadata of an assembly file.
+        /// </summary>
+        /// <param name="fileName">The full path of the file.</param>
+        /// <returns>The metadata, or <see langword="null" /> if the file is not a valid managed assembly.</returns>
+        internal static ScriptAssemblyMetadata Read(string fileName)
+        {
+            try
+            {
+                byte[] metadata;
+                using (var fileStream = new FileStream(fileName, FileMode.Open, FileAccess.Read, FileShare.Read | FileShare.Delete))
+                using (var binaryReader = new BinaryReader(fileStream))
+                {
+                    metadata = ReadMetadataBlock(fileStream, binaryReader);
+                }
+
+                return metadata != null ? Parse(metadata) : null;
+            }
+            catch
+            {
+                // This is likely not a valid assembly if any exceptions occur during reading, the loader will tell why
+                return null;
+            }
+        }
+
+        private static byte[] ReadMetadataBlock(Stream fileStream, BinaryReader binaryReader)
+        {
+            const ushort PE32 = 0x10b;
+            const ushort PE32Plus = 0x20b;
+
+            if (fileStream.Length < 64)
+            {
+                return null;
+            }
+
+            fileStream.Position = 0x3C;
+            fileStream.Position = binaryReader.ReadUInt32();
+            if (binaryReader.ReadUInt32() != 0x00004550)
+            {
+                return null;
+            }
+
+            // COFF file header
+            fileStream.Position += 2;
+            int sectionCount = binaryReader.ReadUInt16();
+            fileStream.Position += 12;
+            int optionalHeaderSize = binaryReader.ReadUInt16();
+            fileStream.Position += 2;
+
+            long optionalHeaderStart = fileStream.Position;
+            ushort peFormat = binaryReader.ReadUInt16();
+            if (peFormat != PE32 && peFormat != PE32Plus)
+            {
+                return null;
+            }
+
+            // The 15th data directory is the CLI header
+            fileStream.Position = optionalHeaderStart + (peFormat == PE32 ? 96 : 112) + 14 * 8;
+            uint cliHeaderRva = binaryReader.ReadUInt32();
+            if (cliHeaderRva == 0)
+            {
+                return null;
+            }
+
+            // Virtual address, virtual size and raw data pointer of each section
+            fileStream.Position = optionalHeaderStart + optionalHeaderSize;
+            uint[] sections = new uint[sectionCount * 3];
+            for (int i = 0; i < sectionCount; i++)
+            {
+                fileStream.Position += 8;
+                uint virtualSize = binaryReader.ReadUInt32();
+                sections[i * 3] = binaryReader.ReadUInt32();
+                uint rawDataSize = binaryReader.ReadUInt32();
+                sections[i * 3 + 1] = Math.Max(virtualSize, rawDataSize);
+                sections[i * 3 + 2] = binaryReader.ReadUInt32();
+                fileStream.Position += 16;
+            }
+
+            long cliHeaderOffset = RvaToFileOffset(sections, cliHeaderRva);
+            if (cliHeaderOffset < 0)
+            {
+                return null;
+            }
+
+            fileStream.Position = cliHeaderOffset + 8;
+            uint metadataRva = binaryReader.ReadUInt32();
+            int metadataSize = binaryReader.ReadInt32();
+            long metadataOffset = RvaToFileOffset(sections, metadataRva);
+            if (metadataOffset < 0 || metadataSize <= 0 || metadataOffset + metadataSize > fileStream.Length)
+            {
+                return null;
+            }
+
+            fileStream.Position = metadataOffset;
+            return binaryReader.ReadBytes(metadataSize);
+        }
+
+        private static long RvaToFileOffset(uint[] sections, uint rva)
+        {
+            for (int i = 0; i < sections.Length; i += 3)
+            {
+                if (rva >= sections[i] && rva - sections[i] < sections[i + 1])
+                {
+                    return rva - sections[i] + sections[i + 2];
+                }
+            }
+
+            return -1;
+        }
+
+        private static ScriptAssemblyMetadata Parse(byte[] metadata)
+        {
+            // Metadata root
+            if (BitConverter.ToUInt32(metadata, 0) != 0x424A5342)
+            {
+                return null;
+            }
+
+            int offset = 16 + BitConverter.ToInt32(metadata, 12) + 2;
+            int streamCount = BitConverter.ToUInt16(metadata, offset);
+            offset += 2;
+
+            int tablesOffset = -1;
+            bool isUncompressedTables = false;
+            int stringsOffset = -1;
+            for (int i = 0; i < streamCount; i++)
+            {
+                int streamOffset = BitConverter.ToInt32(metadata, offset);
+                offset += 8;
+
+                int nameEnd = Array.IndexOf(metadata, (byte)0, offset);
+                string streamName = Encoding.ASCII.GetString(metadata, offset, nameEnd - offset);
+                offset = (nameEnd + 4) & ~3;
+
+                switch (streamName)
+                {
+                    case "#~":
+                    case "#-":
+                        tablesOffset = streamOffset;
+                        isUncompressedTables = streamName == "#-";
+                        break;
+                    case "#Strings":
+                        stringsOffset = streamOffset;
+                        break;
+                }
+            }
+
+            if (tablesOffset < 0 || stringsOffset < 0)
+            {
+                return null;
+            }
+
+            // Tables header
+            byte heapSizes = metadata[tablesOffset + 6];
+            ulong presentTables = BitConverter.ToUInt64(metadata, tablesOffset + 8);
+            int[] rowCounts = new int[64];
+            offset = tablesOffset + 24;
+            for (int i = 0; i < 64; i++)
+            {
+                if ((presentTables & (1UL << i)) != 0)
+                {
+                    rowCounts[i] = BitConverter.ToInt32(metadata, offset);
+                    offset += 4;
+                }
+            }
+            if (isUncompressedTables && (heapSizes & 0x40) != 0)
+            {
+                // Extra data of edit and continue tables
+                offset += 4;
+            }
+
+            int stringIndexSize = (heapSizes & 0x01) != 0 ? 4 : 2;
+            int guidIndexSize = (heapSizes & 0x02) != 0 ? 4 : 2;
+            int blobIndexSize = (heapSizes & 0x04) != 0 ? 4 : 2;
+
+            int typeDefOrRefSize = GetCodedIndexSize(rowCounts, 2, TypeDefTable, TypeRefTable, TypeSpecTable);
+            int resolutionScopeSize = GetCodedIndexSize(rowCounts, 2, ModuleTable, ModuleRefTable, AssemblyRefTable, TypeRefTable);
+            int hasConstantSize = GetCodedIndexSize(rowCounts, 2, FieldTable, ParamTable, PropertyTable);
+            int hasCustomAttributeSize = GetCodedIndexSize(rowCounts, 5, MethodDefTable, FieldTable, TypeRefTable, TypeDefTable, ParamTable,
+                InterfaceImplTable, MemberRefTable, ModuleTable, DeclSecurityTable, PropertyTable, EventTable, StandAloneSigTable,
+                ModuleRefTable, TypeSpecTable, AssemblyTable, AssemblyRefTable, FileTable, ExportedTypeTable, ManifestResourceTable,
+                GenericParamTable, GenericParamConstraintTable, MethodSpecTable);
+            int hasFieldMarshalSize = GetCodedIndexSize(rowCounts, 1, FieldTable, ParamTable);
+            int hasDeclSecuritySize = GetCodedIndexSize(rowCounts, 2, TypeDefTable, MethodDefTable, AssemblyTable);
+            int memberRefParentSize = GetCodedIndexSize(rowCounts, 3, TypeDefTable, TypeRefTable, ModuleRefTable, MethodDefTable, TypeSpecTable);
+            int hasSemanticsSize = GetCodedIndexSize(rowCounts, 1, EventTable, PropertyTable);
+            int methodDefOrRefSize = GetCodedIndexSize(rowCounts, 1, MethodDefTable, MemberRefTable);
+            int memberForwardedSize = GetCodedIndexSize(rowCounts, 1, FieldTable, MethodDefTable);
+            int customAttributeTypeSize = GetCodedIndexSize(rowCounts, 3, MethodDefTable, MemberRefTable);
+
+            int fieldIndexSize = GetIndexSize(rowCounts, FieldTable);
+            int methodDefIndexSize = GetIndexSize(rowCounts, MethodDefTable);
+            int paramIndexSize = GetIndexSize(rowCounts, ParamTable);
+            int typeDefIndexSize = GetIndexSize(rowCounts, TypeDefTable);
+            int eventIndexSize = GetIndexSize(rowCounts, EventTable);
+            int propertyIndexSize = GetIndexSize(rowCounts, PropertyTable);
+            int moduleRefIndexSize = GetIndexSize(rowCounts, ModuleRefTable);
+
+            // Row sizes of all tables up to and including AssemblyRef, which is the last table read here
+            int[] rowSizes =
+            {
+                2 + stringIndexSize + guidIndexSize * 3, // Module
+                resolutionScopeSize + stringIndexSize * 2, // TypeRef
+                4 + stringIndexSize * 2 + typeDefOrRefSize + fieldIndexSize + methodDefIndexSize, // TypeDef
+                fieldIndexSize, // FieldPtr
+                2 + stringIndexSize + blobIndexSize, // Field
+                methodDefIndexSize, // MethodPtr
+                8 + stringIndexSize + blobIndexSize + paramIndexSize, // MethodDef
+                paramIndexSize, // ParamPtr
+                4 + stringIndexSize, // Param
+                typeDefIndexSize + typeDefOrRefSize, // InterfaceImpl
+                memberRefParentSize + stringIndexSize + blobIndexSize, // MemberRef
+                2 + hasConstantSize + blobIndexSize, // Constant
+                hasCustomAttributeSize + customAttributeTypeSize + blobIndexSize, // CustomAttribute
+                hasFieldMarshalSize + blobIndexSize, // FieldMarshal
+                2 + hasDeclSecuritySize + blobIndexSize, // DeclSecurity
+                6 + typeDefIndexSize, // ClassLayout
+                4 + fieldIndexSize, // FieldLayout
+                blobIndexSize, // StandAloneSig
+                typeDefIndexSize + eventIndexSize, // EventMap
+                eventIndexSize, // EventPtr
+                2 + stringIndexSize + typeDefOrRefSize, // Event
+                typeDefIndexSize + propertyIndexSize, // PropertyMap
+                propertyIndexSize, // PropertyPtr
+                2 + stringIndexSize + blobIndexSize, // Property
+                2 + methodDefIndexSize + hasSemanticsSize, // MethodSemantics
+                typeDefIndexSize + methodDefOrRefSize * 2, // MethodImpl
+                stringIndexSize, // ModuleRef
+                blobIndexSize, // TypeSpec
+                2 + memberForwardedSize + stringIndexSize + moduleRefIndexSize, // ImplMap
+                4 + fieldIndexSize, // FieldRVA
+                8, // EncLog
+                4, // EncMap
+                16 + blobIndexSize + stringIndexSize * 2, // Assembly
+                4, // AssemblyProcessor
+                12, // AssemblyOS
+                12 + blobIndexSize * 2 + stringIndexSize * 2, // AssemblyRef
+            };
+
+            int[] tableOffsets = new int[rowSizes.Length];
+            for (int i = 0; i < rowSizes.Length; i++)
+            {
+                tableOffsets[i] = offset;
+                offset += rowSizes[i] * rowCounts[i];
+            }
+            if (offset > metadata.Length)
+            {
+                return null;
+            }
+
+            var result = new ScriptAssemblyMetadata();
+
+            if (rowCounts[AssemblyTable] == 0)
+            {
+                // A module without an assembly manifest cannot be loaded as a script assembly
+                return null;
+            }
+
+            int assemblyRow = tableOffsets[AssemblyTable];
+            result.Version = ReadVersion(metadata, assemblyRow + 4);
+            result.Name = ReadString(metadata, stringsOffset, ReadIndex(metadata, assemblyRow + 16 + blobIndexSize, stringIndexSize));
+
+            var referencedAssemblies = new AssemblyName[rowCounts[AssemblyRefTable]];
+            bool[] isApiAssemblyRef = new bool[referencedAssemblies.Length];
+            bool[] isFrameworkAssemblyRef = new bool[referencedAssemblies.Length];
+            for (int i = 0; i < referencedAssemblies.Length; i++)
+            {
+                int row = tableOffsets[AssemblyRefTable] + i * rowSizes[AssemblyRefTable];
+                string name = ReadString(metadata, stringsOffset, ReadIndex(metadata, row + 12 + blobIndexSize, stringIndexSize));
+
+                referencedAssemblies[i] = new AssemblyName { Name = name, Version = ReadVersion(metadata, row) };
+                isApiAssemblyRef[i] = name.StartsWith("ScriptHookVDotNet", StringComparison.OrdinalIgnoreCase);
+                isFrameworkAssemblyRef[i] = IsFrameworkAssemblyName(name);
+                result.ReferencesScriptingApi |= isApiAssemblyRef[i];
+            }
+            result.ReferencedAssemblies = referencedAssemblies;
+
+            if (!result.ReferencesScriptingApi)
+            {
+                // No script types without `GTA.Script`, so there is no need to look at the types
+                return result;
+            }
+
+            // Classify the base types referenced from other assemblies
+            var typeRefKinds = new BaseTypeKind[rowCounts[TypeRefTable]];
+            for (int i = 0; i < typeRefKinds.Length; i++)
+            {
+                typeRefKinds[i] = ClassifyTypeRef(i);
+            }
+
+            var typeDefKinds = new BaseTypeKind?[rowCounts[TypeDefTable]];
+            int possibleScriptTypeCount = 0;
+            for (int i = 0; i < typeDefKinds.Length; i++)
+            {
+                if (ClassifyTypeDef(i) != BaseTypeKind.None)
+                {
+                    possibleScriptTypeCount++;
+                }
+            }
+            result.PossibleScriptTypeCount = possibleScriptTypeCount;
+
+            return result;
+
+            BaseTypeKind ClassifyTypeRef(int typeRefIndex)
+            {
+                int row = tableOffsets[TypeRefTable] + typeRefIndex * rowSizes[TypeRefTable];
+                int resolutionScope = ReadIndex(metadata, row, resolutionScopeSize);
+                string name = ReadString(metadata, stringsOffset, ReadIndex(metadata, row + resolutionScopeSize, stringIndexSize));
+                string ns = ReadString(metadata, stringsOffset, ReadIndex(metadata, row + resolutionScopeSize + stringIndexSize, stringIndexSize));
+
+                // Nested types are scoped to their declaring type, so walk up to the outermost one to find the assembly
+                for (int depth = 0; (resolutionScope & 3) == 3 && depth < typeRefKinds.Length; depth++)
+                {
+                    int outerRow = tableOffsets[TypeRefTable] + ((resolutionScope >> 2) - 1) * rowSizes[TypeRefTable];
+                    resolutionScope = ReadIndex(metadata, outerRow, resolutionScopeSize);
+                }
+
+                if ((resolutionScope & 3) != 2 || (resolutionScope >> 2) == 0)
+                {
+                    // Defined in this assembly or in another module of it, which is rare enough to not bother
+                    return BaseTypeKind.Unknown;
+                }
+
+                int assemblyRefIndex = (resolutionScope >> 2) - 1;
+                if (isApiAssemblyRef[assemblyRefIndex])
+                {
+                    // No other API type derives from `GTA.Script`
+                    return ns == "GTA" && name == "Script" ? BaseTypeKind.Script : BaseTypeKind.None;
+                }
+
+                return isFrameworkAssemblyRef[assemblyRefIndex] ? BaseTypeKind.None : BaseTypeKind.Unknown;
+            }
+
+            BaseTypeKind ClassifyTypeDef(int typeDefIndex)
+            {
+                BaseTypeKind kind = FollowBaseTypes(typeDefIndex);
+                typeDefKinds[typeDefIndex] = kind;
+                return kind;
+            }
+
+            BaseTypeKind FollowBaseTypes(int typeDefIndex)
+            {
+                // Follow the base types in this assembly until one from another assembly is found
+                int current = typeDefIndex;
+                for (int depth = 0; depth < typeDefKinds.Length; depth++)
+                {
+                    if (typeDefKinds[current] is BaseTypeKind knownKind)
+                    {
+                        return knownKind;
+                    }
+
+                    int row = tableOffsets[TypeDefTable] + current * rowSizes[TypeDefTable];
+                    int extends = ReadIndex(metadata, row + 4 + stringIndexSize * 2, typeDefOrRefSize);
+                    int extendsRowIndex = (extends >> 2) - 1;
+                    if (extendsRowIndex < 0)
+                    {
+                        // Interfaces and `System.Object`
+                        return BaseTypeKind.None;
+                    }
+
+                    switch (extends & 3)
+                    {
+                        case 0:
+                            current = extendsRowIndex;
+                            continue;
+                        case 1:
+                            return typeRefKinds[extendsRowIndex];
+                        default:
+                            // Generic instantiations can derive from anything
+                            return BaseTypeKind.Unknown;
+                    }
+                }
+
+                // Circular base types, the loader will reject the type
+                return BaseTypeKind.None;
+            }
+        }
+
+        private static bool IsFrameworkAssemblyName(string name)
+        {
+            return name == "mscorlib" || name == "netstandard"
+                || name.StartsWith("System", StringComparison.Ordinal)
+                || name.StartsWith("Microsoft.", StringComparison.Ordinal);
+        }
+
+        private static int GetIndexSize(int[] rowCounts, int table)
+        {
+            return rowCounts[table] < 0x10000 ? 2 : 4;
+        }
+        private static int GetCodedIndexSize(int[] rowCounts, int tagBits, params int[] tables)
+        {
+            int maxRowCount = 0;
+            foreach (int table in tables)
+            {
+                maxRowCount = Math.Max(maxRowCount, rowCounts[table]);
+            }
+
+            return maxRowCount < (1 << (16 - tagBits)) ? 2 : 4;
+        }
+
+        private static int ReadIndex(byte[] metadata, int offset, int size)
+        {
+            return size == 2 ? BitConverter.ToUInt16(metadata, offset) : BitConverter.ToInt32(metadata, offset);
+        }
+        private static Version ReadVersion(byte[] metadata, int offset)
+        {
+            return new Version(
+                BitConverter.ToUInt16(metadata, offset),
+                BitConverter.ToUInt16(metadata, offset + 2),
+                BitConverter.ToUInt16(metadata, offset + 4),
+                BitConverter.ToUInt16(metadata, offset + 6));
+        }
+        private static string ReadString(byte[] metadata, int stringsOffset, int index)
+        {
+            int start = stringsOffset + index;
+            int end = Array.IndexOf(metadata, (byte)0, start);
+            return Encoding.UTF8.GetString(metadata, start, end - start);
+        }
+    }
+}
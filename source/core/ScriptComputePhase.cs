@@ -0,0 +1,315 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Threading.Tasks;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// The state of a ped or vehicle at the start of a frame.
+    /// </summary>
+    /// <remarks>
+    /// No script handle is created for the entity, since that can only be done on the main thread and fills the script
+    /// guid pool. Pass the entity to <see cref="NativeCallBatch.PushArgument(in FrameEntity)"/> to have a handle created
+    /// right before the deferred calls are executed.
+    /// </remarks>
+    public readonly struct FrameEntity
+    {
+        internal FrameEntity(ulong address, int modelHash, FVector3 position, float health)
+        {
+            Address = address;
+            ModelHash = modelHash;
+            Position = position;
+            Health = health;
+        }
+
+        internal ulong Address { get; }
+        public int ModelHash { get; }
+        public FVector3 Position { get; }
+        /// <summary>
+        /// Gets the health of the entity, or zero if the health offset was not found in the game executable.
+        /// </summary>
+        public float Health { get; }
+    }
+
+    /// <summary>
+    /// A read-only view of the world taken at the start of a frame, which compute handlers can read from any thread.
+    /// </summary>
+    /// <remarks>
+    /// The entity buffers are reused in the next frame, so do not keep a snapshot after the compute handler returns.
+    /// </remarks>
+    public readonly struct FrameSnapshot
+    {
+        private readonly FrameEntity[] _peds;
+        private readonly FrameEntity[] _vehicles;
+
+        internal FrameSnapshot(long frameCount, int gameTime, float frameTime, int playerPedHandle, FVector3 playerPosition,
+            FrameEntity[] peds, int pedCount, FrameEntity[] vehicles, int vehicleCount)
+        {
+            FrameCount = frameCount;
+            GameTime = gameTime;
+            FrameTime = frameTime;
+            PlayerPedHandle = playerPedHandle;
+            PlayerPosition = playerPosition;
+            _peds = peds;
+            PedCount = pedCount;
+            _vehicles = vehicles;
+            VehicleCount = vehicleCount;
+        }
+
+        /// <summary>
+        /// Gets the number of frames the script domain has run, which is the same as <see cref="ScriptDomain.FrameCount"/>.
+        /// </summary>
+        public long FrameCount { get; }
+        /// <summary>
+        /// Gets the game time in milliseconds.
+        /// </summary>
+        public int GameTime { get; }
+        /// <summary>
+        /// Gets the time the last frame took in seconds.
+        /// </summary>
+        public float FrameTime { get; }
+        public int PlayerPedHandle { get; }
+        public FVector3 PlayerPosition { get; }
+
+        public int PedCount { get; }
+        public int VehicleCount { get; }
+
+        public ref readonly FrameEntity GetPed(int index)
+        {
+            if ((uint)index >= (uint)PedCount)
+            {
+                throw new ArgumentOutOfRangeException(nameof(index));
+            }
+
+            return ref _peds[index];
+        }
+        public ref readonly FrameEntity GetVehicle(int index)
+        {
+            if ((uint)index >= (uint)VehicleCount)
+            {
+                throw new ArgumentOutOfRangeException(nameof(index));
+            }
+
+            return ref _vehicles[index];
+        }
+    }
+
+    /// <summary>
+    /// Represents the method that computes the work of a script for a frame on a worker thread.
+    /// </summary>
+    /// <param name="snapshot">The state of the world at the start of the frame.</param>
+    /// <param name="deferredCalls">
+    /// The script functions to call on the main thread once all compute handlers are done. The batch is cleared before
+    /// each call.
+    /// </param>
+    public delegate void ScriptComputeHandler(in FrameSnapshot snapshot, NativeCallBatch deferredCalls);
+
+    /// <summary>
+    /// Runs the compute handlers of all scripts in parallel at the start of each frame and then calls the script
+    /// functions they deferred on the main thread, one script after another.
+    /// </summary>
+    /// <remarks>
+    /// Compute handlers run on the thread pool, whose work-stealing queues spread the scripts over all cores, so the time
+    /// of the phase depends on the slowest script instead of the sum of all of them. Script functions can only be called
+    /// on the main thread, so calling one from a compute handler throws and is reported as an unhandled exception of
+    /// the script. The snapshot is only taken while at least one running script has a compute handler.
+    /// </remarks>
+    internal sealed class ScriptComputePhase
+    {
+        private const ulong GetGameTimerHash = 0x9CD27B0045628463;
+        private const ulong GetFrameTimeHash = 0x15C40837039FFAF7;
+        private const ulong PlayerPedIdHash = 0xD80958FC74E988A6;
+
+        [ThreadStatic]
+        private static Script s_computingScript;
+
+        private readonly Action<int> _runComputeHandler;
+        private Script[] _scripts = Array.Empty<Script>();
+        private Exception[] _exceptions = Array.Empty<Exception>();
+        private int _scriptCount;
+        private FrameSnapshot _snapshot;
+        // Whether the full script guid pool has been reported and not been resolved since
+        private bool _hasReportedFullGuidPool;
+
+        private ulong[] _entityAddresses = Array.Empty<ulong>();
+        private FrameEntity[] _peds = Array.Empty<FrameEntity>();
+        private FrameEntity[] _vehicles = Array.Empty<FrameEntity>();
+
+        internal ScriptComputePhase()
+        {
+            _runComputeHandler = RunComputeHandler;
+        }
+
+        /// <summary>
+        /// Gets the script whose compute handler runs on the current thread, or <see langword="null" /> if there is none.
+        /// </summary>
+        internal static Script ComputingScript => s_computingScript;
+
+        /// <summary>
+        /// Adds a script to the scripts of this frame if it has a compute handler.
+        /// </summary>
+        internal void AddScript(Script script)
+        {
+            if (!script.HasComputeHandler)
+            {
+                return;
+            }
+
+            if (_scriptCount == _scripts.Length)
+            {
+                Array.Resize(ref _scripts, Math.Max(_scripts.Length * 2, 4));
+                Array.Resize(ref _exceptions, _scripts.Length);
+            }
+
+            _scripts[_scriptCount++] = script;
+        }
+
+        /// <summary>
+        /// Runs the compute handlers of the added scripts and the script functions they deferred, then forgets the
+        /// scripts. Must be called on the main thread.
+        /// </summary>
+        /// <param name="frameCount">The number of frames the script domain has run.</param>
+        internal void Run(long frameCount)
+        {
+            if (_scriptCount == 0)
+            {
+                return;
+            }
+
+            TakeSnapshot(frameCount);
+            int unresolvedEntityCount = 0;
+
+            try
+            {
+                if (_scriptCount == 1)
+                {
+                    RunComputeHandler(0);
+                }
+                else
+                {
+                    Parallel.For(0, _scriptCount, _runComputeHandler);
+                }
+
+                // Apply phase, in the same order the scripts tick in
+                for (int i = 0; i < _scriptCount; i++)
+                {
+                    Script script = _scripts[i];
+
+                    if (_exceptions[i] != null)
+                    {
+                        ScriptDomain.HandleUnhandledException(script, new UnhandledExceptionEventArgs(_exceptions[i], false));
+                        _exceptions[i] = null;
+                    }
+
+                    NativeCallBatch deferredCalls = script.DeferredNativeCalls;
+                    if (deferredCalls.Count != 0)
+                    {
+                        unresolvedEntityCount += deferredCalls.ResolveEntityArguments();
+                        unsafe
+                        {
+                            deferredCalls.InvokeInternal();
+                        }
+                        deferredCalls.Clear();
+                    }
+
+                    script.HasPendingApply = true;
+                }
+
+                ReportUnresolvedEntities(unresolvedEntityCount);
+            }
+            finally
+            {
+                Array.Clear(_scripts, 0, _scriptCount);
+                _scriptCount = 0;
+            }
+        }
+
+        private void RunComputeHandler(int index)
+        {
+            Script script = _scripts[index];
+            NativeCallBatch deferredCalls = script.DeferredNativeCalls;
+            deferredCalls.Clear();
+
+            s_computingScript = script;
+            try
+            {
+                script.RaiseCompute(in _snapshot, deferredCalls);
+            }
+            catch (Exception ex)
+            {
+                // Calls recorded before the exception are dropped, so a half-computed frame is not applied
+                deferredCalls.Clear();
+                _exceptions[index] = ex;
+            }
+            finally
+            {
+                s_computingScript = null;
+            }
+        }
+
+        private void ReportUnresolvedEntities(int unresolvedEntityCount)
+        {
+            if (unresolvedEntityCount == 0)
+            {
+                _hasReportedFullGuidPool = false;
+                return;
+            }
+            if (_hasReportedFullGuidPool)
+            {
+                return;
+            }
+
+            Log.Message(Log.Level.Warning, "The script guid pool is full, so ", unresolvedEntityCount.ToString(),
+                " entities of the frame snapshot were passed to deferred calls as zero handles.");
+            _hasReportedFullGuidPool = true;
+        }
+
+        private unsafe void TakeSnapshot(long frameCount)
+        {
+            int gameTime = *(int*)NativeFunc.InvokeInternal(GetGameTimerHash, null, 0);
+            float frameTime = *(float*)NativeFunc.InvokeInternal(GetFrameTimeHash, null, 0);
+            int playerPedHandle = *(int*)NativeFunc.InvokeInternal(PlayerPedIdHash, null, 0);
+
+            var playerPosition = new FVector3();
+            IntPtr playerPedAddress = NativeMemory.GetEntityAddress(playerPedHandle);
+            if (playerPedAddress != IntPtr.Zero)
+            {
+                playerPosition = NativeMemory.GetEntityPositionFromAddress((ulong)playerPedAddress.ToInt64());
+            }
+
+            int entityCount = NativeMemory.CopyPedAndVehicleAddresses(ref _entityAddresses, out int pedAddressCount);
+            if (_peds.Length < pedAddressCount)
+            {
+                _peds = new FrameEntity[pedAddressCount];
+            }
+            if (_vehicles.Length < entityCount - pedAddressCount)
+            {
+                _vehicles = new FrameEntity[entityCount - pedAddressCount];
+            }
+
+            int healthOffset = NativeMemory.EntityHealthOffset;
+            int pedCount = 0;
+            int vehicleCount = 0;
+            for (int i = 0; i < entityCount; i++)
+            {
+                ulong address = _entityAddresses[i];
+                var entity = new FrameEntity(address, NativeMemory.GetModelHashFromEntity(new IntPtr((long)address)),
+                    NativeMemory.GetEntityPositionFromAddress(address), healthOffset != 0 ? *(float*)(address + (uint)healthOffset) : 0f);
+                if (i < pedAddressCount)
+                {
+                    _peds[pedCount++] = entity;
+                }
+                else
+                {
+                    _vehicles[vehicleCount++] = entity;
+                }
+            }
+
+            _snapshot = new FrameSnapshot(frameCount, gameTime, frameTime, playerPedHandle, playerPosition, _peds, pedCount, _vehicles, vehicleCount);
+        }
+    }
+}
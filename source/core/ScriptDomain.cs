@@ -6,6 +6,7 @@
 using System;
 using System.CodeDom.Compiler;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.IO;
 using System.Linq;
 using System.Reflection;
@@ -113,6 +114,14 @@ namespace SHVDN
         private bool _recordKeyboardEvents = true;
         private bool[] _keyboardState = new bool[256];
         private readonly List<Assembly> _scriptingApiAsms = new List<Assembly>();
+        private readonly ScriptAssemblyCache _assemblyCache = new(ScriptAssemblyCache.GetDefaultCacheDirectory(AppDomain.CurrentDomain.BaseDirectory));
+        // Maps assembly file names without extension to their path in the scripts directory, built on the first resolve
+        private Dictionary<string, string> _dependencyPaths;
+        private readonly ScriptMessageBus _messageBus = new();
+        private readonly EntityEventStream _entityEventStream;
+        private readonly StreamingRequestManager _streamingRequests = new();
+        private readonly ScriptComputePhase _computePhase = new();
+        private long _frameCount;
         private readonly HashSet<string> _scriptingApiAsmNamesCache = new HashSet<string>();
         private readonly Dictionary<int, Type> _scriptingGtaClassTypesCacheDict = new Dictionary<int, Type>();
         // Intentionally use array over `HashSet` because only 2 or 3 elements will be inserted for sure, where
@@ -255,6 +264,128 @@ namespace SHVDN
             }
         }
 
+        /// <summary>
+        /// Gets snapshots of the execution metrics of all the running scripts in this script domain.
+        /// </summary>
+        public ScriptMetricsSnapshot[] GetScriptMetrics()
+        {
+            Script[] scripts = RunningScripts;
+            var metrics = new ScriptMetricsSnapshot[scripts.Length];
+            for (int i = 0; i < scripts.Length; i++)
+            {
+                metrics[i] = scripts[i].GetMetrics();
+            }
+
+            return metrics;
+        }
+
+        /// <summary>
+        /// Gets the message bus scripts in this script domain use to communicate with each other.
+        /// </summary>
+        internal ScriptMessageBus MessageBus => _messageBus;
+
+        /// <summary>
+        /// Creates a message channel owned by the executing script. The channel is closed when the script is aborted.
+        /// </summary>
+        /// <param name="name">The name of the channel.</param>
+        /// <param name="capacity">The minimum number of messages the channel can buffer for each subscriber.</param>
+        /// <exception cref="InvalidOperationException">No script is executing.</exception>
+        public ScriptMessageChannel<T> CreateMessageChannel<T>(string name, int capacity)
+        {
+            return _messageBus.CreateChannel<T>(GetExecutingScriptForMessageBus(), name, capacity);
+        }
+        /// <summary>
+        /// Subscribes the executing script to a message channel. Messages are delivered at the start of each tick of the script.
+        /// </summary>
+        /// <param name="name">The name of the channel. The channel does not need to exist yet.</param>
+        /// <param name="handler">The method that is called with each message.</param>
+        /// <exception cref="InvalidOperationException">No script is executing.</exception>
+        public ScriptMessageSubscription SubscribeToMessageChannel<T>(string name, Action<T> handler)
+        {
+            return _messageBus.Subscribe(GetExecutingScriptForMessageBus(), name, handler);
+        }
+
+        /// <summary>
+        /// Subscribes the executing script to the damage records added to peds and vehicles. Events are delivered at
+        /// the start of each tick of the script, like messages of a message channel.
+        /// </summary>
+        /// <param name="handler">The method that is called with each event.</param>
+        /// <exception cref="InvalidOperationException">No script is executing.</exception>
+        public ScriptMessageSubscription SubscribeToEntityDamageEvents(Action<EntityDamageEvent> handler)
+        {
+            return _messageBus.Subscribe(GetExecutingScriptForMessageBus(), EntityEventStream.DamageChannelName, handler);
+        }
+        /// <summary>
+        /// Subscribes the executing script to the collisions of peds and vehicles with other peds, vehicles or objects.
+        /// Events are delivered at the start of each tick of the script, like messages of a message channel.
+        /// </summary>
+        /// <param name="handler">The method that is called with each event.</param>
+        /// <exception cref="InvalidOperationException">No script is executing.</exception>
+        public ScriptMessageSubscription SubscribeToEntityCollisionEvents(Action<EntityCollisionEvent> handler)
+        {
+            return _messageBus.Subscribe(GetExecutingScriptForMessageBus(), EntityEventStream.CollisionChannelName, handler);
+        }
+
+        /// <summary>
+        /// Gets the manager that loads streaming assets on behalf of the scripts in this script domain.
+        /// </summary>
+        internal StreamingRequestManager StreamingRequests => _streamingRequests;
+
+        /// <summary>
+        /// Gets the number of times this script domain has ticked.
+        /// </summary>
+        public long FrameCount => Interlocked.Read(ref _frameCount);
+
+        /// <summary>
+        /// Makes the executing script hold a streaming asset and starts loading it if no script requested it yet.
+        /// The asset stays loaded until every script that holds it released it or was aborted.
+        /// </summary>
+        /// <param name="assetType">The kind of the asset.</param>
+        /// <param name="hash">The model hash. Only used for <see cref="StreamingAssetType.Model"/>.</param>
+        /// <param name="name">The asset name. Not used for <see cref="StreamingAssetType.Model"/>.</param>
+        /// <returns>The shared request for the asset, or <see langword="null" /> if no script is executing.</returns>
+        public StreamingRequest AcquireStreamingAsset(StreamingAssetType assetType, int hash, string name)
+        {
+            return _streamingRequests.Acquire(assetType, hash, name);
+        }
+        /// <summary>
+        /// Releases the hold of the executing script on a streaming asset.
+        /// </summary>
+        /// <returns>
+        /// <see langword="true" /> if scripts requested the asset through this script domain, which then unloads it once
+        /// nobody holds it anymore; otherwise, <see langword="false" />.
+        /// </returns>
+        public bool ReleaseStreamingAsset(StreamingAssetType assetType, int hash, string name)
+        {
+            return _streamingRequests.Release(assetType, hash, name);
+        }
+        /// <summary>
+        /// Starts loading a streaming asset without holding it, so scripts that request it later do not need to wait.
+        /// </summary>
+        /// <param name="keepAliveMilliseconds">How long the asset is kept loaded if no script holds it.</param>
+        public StreamingRequest PrefetchStreamingAsset(StreamingAssetType assetType, int hash, string name, int keepAliveMilliseconds)
+        {
+            return _streamingRequests.Prefetch(assetType, hash, name, keepAliveMilliseconds);
+        }
+        /// <summary>
+        /// Gets a snapshot of the queue depth and load times of the streaming requests of this script domain.
+        /// </summary>
+        public StreamingStatisticsSnapshot GetStreamingStatistics()
+        {
+            return _streamingRequests.GetStatistics();
+        }
+
+        private Script GetExecutingScriptForMessageBus()
+        {
+            Script script = ExecutingScript;
+            if (script == null)
+            {
+                throw new InvalidOperationException("Message channels can only be used from a script.");
+            }
+
+            return script;
+        }
+
         /// <summary>
         /// Gets the currently executing script or <see langword="null" /> if there is none.
         /// </summary>
@@ -298,6 +429,8 @@ namespace SHVDN
             // Each application domain has its own copy of this static variable, so only need to set it once
             CurrentDomain = this;
 
+            _entityEventStream = new EntityEventStream(_messageBus);
+
             // Attach resolve handler to new domain
             AppDomain.AssemblyResolve += HandleResolve;
             AppDomain.UnhandledException += HandleUnhandledException;
@@ -426,9 +559,10 @@ namespace SHVDN
             hashCodeForAppDomain = hashCodeForAppDomain * 23 + Environment.TickCount.GetHashCode();
             string name = "SHVDN_ScriptDomain_" + hashCodeForAppDomain.ToString("X");
             var setup = new AppDomainSetup();
-            setup.ShadowCopyFiles = "true"; // Copy assemblies to another location than locking the file, so the original assembly files can be updated while the domain is still loaded (the copied assemblies will be locked)
-            setup.ShadowCopyDirectories = scriptPath; // Only shadow copy files in the scripts directory
             setup.ApplicationBase = scriptPath;
+            // Script assemblies and their dependencies are loaded from copies in the assembly cache, so the original files can be updated while the domain is still loaded.
+            // Disable probing so dependencies are never loaded (and locked) from the scripts directory by the binder, but always resolved through the cache in `HandleResolve`.
+            setup.DisallowApplicationBaseProbing = true;
 
             var appdomain = AppDomain.CreateDomain(name, null, setup, new System.Security.PermissionSet(System.Security.Permissions.PermissionState.Unrestricted));
             appdomain.InitializeLifetimeService(); // Give the application domain an infinite lifetime
@@ -635,10 +769,11 @@ namespace SHVDN
         /// Loads scripts from the specified assembly file.
         /// </summary>
         /// <param name="filename">The path to the assembly file to load.</param>
+        /// <param name="shadowCopyPath">The path to the shadow copy of the assembly file if it is already prepared.</param>
         /// <returns><see langword="true" /> on success, <see langword="false" /> otherwise</returns>
-        private bool LoadScriptsFromAssembly(string filename)
+        private bool LoadScriptsFromAssembly(string filename, string shadowCopyPath = null)
         {
-            if (!IsManagedAssembly(filename))
+            if (!_assemblyCache.IsManagedAssembly(filename, IsManagedAssembly))
             {
                 return false;
             }
@@ -651,7 +786,8 @@ namespace SHVDN
             try
             {
                 // Note: This loads the assembly only the first time and afterwards returns the already loaded assembly!
-                assembly = Assembly.LoadFrom(filename);
+                // Updated files are stored at a different path in the cache, so they are loaded again.
+                assembly = Assembly.LoadFrom(shadowCopyPath ?? _assemblyCache.GetShadowCopyPath(filename));
             }
             catch (Exception ex)
             {
@@ -1206,58 +1342,59 @@ namespace SHVDN
                 return;
             }
 
+            DateTime loadStartTimeUtc = DateTime.UtcNow;
+            long phaseStartTimestamp = Stopwatch.GetTimestamp();
+
             // Find all script files and assemblies in the specified script directory
             var sourceFiles = new List<string>();
-            var assemblyFiles = new List<string>();
+            string[] assemblyFiles = Array.Empty<string>();
 
             try
             {
                 sourceFiles.AddRange(Directory.GetFiles(ScriptPath, "*.vb", SearchOption.AllDirectories));
                 sourceFiles.AddRange(Directory.GetFiles(ScriptPath, "*.cs", SearchOption.AllDirectories));
 
-                assemblyFiles.AddRange(Directory.GetFiles(ScriptPath, "*.dll", SearchOption.AllDirectories)
-                    .Where(x => IsManagedAssembly(x)));
+                assemblyFiles = Directory.GetFiles(ScriptPath, "*.dll", SearchOption.AllDirectories);
             }
             catch (Exception ex)
             {
                 Log.Message(Log.Level.Error, "Failed to reload scripts: ", ex.ToString());
             }
 
-            // Filter out non-script assemblies
-            for (int i = 0; i < assemblyFiles.Count; i++)
-            {
-                try
-                {
-                    var assemblyName = AssemblyName.GetAssemblyName(assemblyFiles[i]);
-
-                    if (!assemblyName.Name.StartsWith("ScriptHookVDotNet", StringComparison.OrdinalIgnoreCase))
-                    {
-                        continue;
-                    }
-
-                    // Delete copies of SHVDN, since these can cause issues with the assembly binder loading multiple copies
-                    File.Delete(assemblyFiles[i]);
-
-                    assemblyFiles.RemoveAt(i--);
-                }
-                catch (Exception ex)
-                {
-                    Log.Message(Log.Level.Warning, "Ignoring assembly file ", Path.GetFileName(assemblyFiles[i]), " because of exception: ", ex.ToString());
+            // Inspect the assembly files in parallel. This only reads the files and prepares their shadow copies,
+            // everything that changes the state of the domain is done in order on this thread afterwards.
+            var discoveredAssemblies = new DiscoveredScriptAssembly[assemblyFiles.Length];
+            Parallel.For(0, assemblyFiles.Length, i => discoveredAssemblies[i] = DiscoverScriptAssembly(assemblyFiles[i]));
 
-                    assemblyFiles.RemoveAt(i--);
-                }
-            }
+            long discoveryTime = Stopwatch.GetTimestamp() - phaseStartTimestamp;
+            phaseStartTimestamp = Stopwatch.GetTimestamp();
 
             foreach (string filename in sourceFiles)
             {
                 LoadScriptsFromSource(filename);
             }
 
-            foreach (string filename in assemblyFiles)
+            long compilationTime = Stopwatch.GetTimestamp() - phaseStartTimestamp;
+            phaseStartTimestamp = Stopwatch.GetTimestamp();
+
+            int loadedAssemblyCount = 0;
+            foreach (DiscoveredScriptAssembly discoveredAssembly in discoveredAssemblies)
             {
-                LoadScriptsFromAssembly(filename);
+                if (discoveredAssembly == null || !ShouldLoadDiscoveredScriptAssembly(discoveredAssembly))
+                {
+                    continue;
+                }
+
+                LoadScriptsFromAssembly(discoveredAssembly.FileName, discoveredAssembly.ShadowCopyPath);
+                loadedAssemblyCount++;
             }
 
+            // All script assemblies are loaded (and their copies locked) now, so the copies of older builds can go
+            _assemblyCache.CollectGarbage(loadStartTimeUtc);
+
+            long loadingTime = Stopwatch.GetTimestamp() - phaseStartTimestamp;
+            phaseStartTimestamp = Stopwatch.GetTimestamp();
+
             if (DeprecatedScriptAssemblyNamesPerApiVersion.Count > 0)
             {
                 WarnOfScriptsUsingDeprecatedApi();
@@ -1299,6 +1436,15 @@ namespace SHVDN
                             || !NoScriptThread);
             }
 
+            long instantiationTime = Stopwatch.GetTimestamp() - phaseStartTimestamp;
+
+            Log.Message(Log.Level.Info, "Loaded scripts from ", sourceFiles.Count.ToString(), " source file(s) and ",
+                loadedAssemblyCount.ToString(), " of ", assemblyFiles.Length.ToString(), " assembly file(s), started ",
+                scriptTypesToInstantiate.Count.ToString(), " script(s) (discovery: ", FormatElapsedMilliseconds(discoveryTime),
+                ", compilation: ", FormatElapsedMilliseconds(compilationTime),
+                ", loading: ", FormatElapsedMilliseconds(loadingTime),
+                ", instantiation: ", FormatElapsedMilliseconds(instantiationTime), ").");
+
             void WarnOfScriptsUsingDeprecatedApi()
             {
                 if (ShouldWarnOfScriptsBuiltAgainstDeprecatedApiWithTicker)
@@ -1397,6 +1543,9 @@ namespace SHVDN
 
                 _scriptTypes.Clear();
                 _runningScripts.Clear();
+
+                // The aborted scripts released their assets, but the next tick that would unload them may never come
+                _streamingRequests.ReleaseAll();
             }
             finally
             {
@@ -1476,6 +1625,8 @@ namespace SHVDN
         /// <param name="task">The task to execute.</param>
         public void ExecuteTaskWithGameThreadTlsContext(IScriptTask task, bool forceResetTimeoutStopwatch = false)
         {
+            ThrowIfInComputePhase();
+
             bool timeoutStopwatchHasBeenReset;
             if (forceResetTimeoutStopwatch)
             {
@@ -1549,12 +1700,26 @@ namespace SHVDN
             }
         }
 
+        private static void ThrowIfInComputePhase()
+        {
+            // Compute handlers run on worker threads in parallel with each other, where calling into the game is not
+            // safe even with the TLS context of the main thread
+            Script computingScript = ScriptComputePhase.ComputingScript;
+            if (computingScript != null)
+            {
+                throw new InvalidOperationException($"The script \"{computingScript.Name}\" called a script function in its compute handler. " +
+                    "Add the call to the batch passed to the compute handler instead.");
+            }
+        }
+
         /// <summary>
         /// Execute a script task in this script domain.
         /// </summary>
         /// <param name="task">The task to execute.</param>
         public void ExecuteTaskInScriptDomainThread(IScriptTask task)
         {
+            ThrowIfInComputePhase();
+
             // Timeout stopwatch should always be reset, as an `IScriptTask` that must be executed in the script domain
             // may take time to execute longer than the timeout threshold in poor PC environments but not in good ones.
             ResetTimeoutStopwatchOfExecutingScript();
@@ -1614,6 +1779,31 @@ namespace SHVDN
         /// </summary>
         internal void DoTick()
         {
+            Interlocked.Increment(ref _frameCount);
+
+            // Scan for damage and collision events once for all scripts before any of them runs
+            _entityEventStream.Update();
+            // Poll pending streaming requests once for all scripts waiting on them
+            _streamingRequests.Update();
+
+            // Run the compute handlers of all scripts in parallel and then the script functions they deferred
+            _rwLock.EnterReadLock();
+            try
+            {
+                foreach (Script script in _runningScripts)
+                {
+                    if (script.IsRunning && !script.IsPaused)
+                    {
+                        _computePhase.AddScript(script);
+                    }
+                }
+            }
+            finally
+            {
+                _rwLock.ExitReadLock();
+            }
+            _computePhase.Run(FrameCount);
+
             // Execute running scripts. Running scripts count should be read every time we execute `DoTick` on a script
             // because a script may instantiate additional script instances. Otherwise, the loop will end up skipping
             // newly instantiated scripts one tick, which is different from how this `DoTick` works in between v3.0.0
@@ -1646,6 +1836,7 @@ namespace SHVDN
                 }
 
                 script.StopwatchForTimeout.Restart();
+                long tickStartTimestamp = System.Diagnostics.Stopwatch.GetTimestamp();
                 try
                 {
                     if (script.IsUsingThread)
@@ -1669,9 +1860,18 @@ namespace SHVDN
                     }
                     else
                     {
-                        script.DoTick();
+                        script.Metrics.BeginSlice();
+                        try
+                        {
+                            script.DoTick();
+                        }
+                        finally
+                        {
+                            script.Metrics.EndSlice();
+                        }
                     }
                     script.StopwatchForTimeout.Stop();
+                    script.Metrics.CompleteTick(System.Diagnostics.Stopwatch.GetTimestamp() - tickStartTimestamp);
                 }
                 catch (Exception ex)
                 {
@@ -1993,6 +2193,103 @@ namespace SHVDN
             return null;
         }
 
+        private sealed class DiscoveredScriptAssembly
+        {
+            internal DiscoveredScriptAssembly(string fileName, ScriptAssemblyMetadata metadata, string shadowCopyPath)
+            {
+                FileName = fileName;
+                Metadata = metadata;
+                ShadowCopyPath = shadowCopyPath;
+            }
+
+            internal string FileName { get; }
+            /// <summary>
+            /// The metadata of the assembly, or <see langword="null" /> if it could not be read.
+            /// In this case the assembly is loaded the same way as any other to let the loader tell what is wrong.
+            /// </summary>
+            internal ScriptAssemblyMetadata Metadata { get; }
+            /// <summary>
+            /// The path to load the assembly from, or <see langword="null" /> if it will not be loaded.
+            /// </summary>
+            internal string ShadowCopyPath { get; }
+        }
+
+        /// <summary>
+        /// Inspects an assembly file without loading it. Safe to call from multiple threads at once.
+        /// </summary>
+        /// <returns>The result, or <see langword="null" /> if the file is not a managed assembly.</returns>
+        private DiscoveredScriptAssembly DiscoverScriptAssembly(string filename)
+        {
+            if (!_assemblyCache.IsManagedAssembly(filename, IsManagedAssembly))
+            {
+                return null;
+            }
+
+            ScriptAssemblyMetadata metadata = ScriptAssemblyMetadata.Read(filename);
+            if (metadata != null
+                && (IsScriptingApiAssemblyName(metadata.Name) || !metadata.ReferencesScriptingApi || metadata.PossibleScriptTypeCount == 0))
+            {
+                return new DiscoveredScriptAssembly(filename, metadata, null);
+            }
+
+            // Hashing and copying is the most expensive part of loading, so do it here in parallel
+            return new DiscoveredScriptAssembly(filename, metadata, _assemblyCache.GetShadowCopyPath(filename));
+        }
+
+        /// <summary>
+        /// Filters out discovered assemblies that contain no scripts, deleting copies of SHVDN along the way.
+        /// </summary>
+        private static bool ShouldLoadDiscoveredScriptAssembly(DiscoveredScriptAssembly discoveredAssembly)
+        {
+            string filename = discoveredAssembly.FileName;
+            ScriptAssemblyMetadata metadata = discoveredAssembly.Metadata;
+
+            try
+            {
+                string assemblyName = metadata != null ? metadata.Name : AssemblyName.GetAssemblyName(filename).Name;
+                if (IsScriptingApiAssemblyName(assemblyName))
+                {
+                    // Delete copies of SHVDN, since these can cause issues with the assembly binder loading multiple copies
+                    File.Delete(filename);
+                    return false;
+                }
+            }
+            catch (Exception ex)
+            {
+                Log.Message(Log.Level.Warning, "Ignoring assembly file ", Path.GetFileName(filename), " because of exception: ", ex.ToString());
+                return false;
+            }
+
+            if (metadata == null)
+            {
+                return true;
+            }
+
+            // Dependencies are loaded on demand in `HandleResolve` instead
+            if (!metadata.ReferencesScriptingApi)
+            {
+                Log.Message(Log.Level.Debug, "Skipped loading ", Path.GetFileName(filename), " because it does not reference any scripting API.");
+                return false;
+            }
+            if (metadata.PossibleScriptTypeCount == 0)
+            {
+                Log.Message(Log.Level.Debug, "Skipped loading ", Path.GetFileName(filename), " because it contains no script types.");
+                return false;
+            }
+
+            return true;
+        }
+
+        private static bool IsScriptingApiAssemblyName(string assemblyName)
+        {
+            return assemblyName.StartsWith("ScriptHookVDotNet", StringComparison.OrdinalIgnoreCase);
+        }
+
+        private static string FormatElapsedMilliseconds(long stopwatchTicks)
+        {
+            return (stopwatchTicks * 1000.0 / Stopwatch.Frequency).ToString("F1") + " ms";
+        }
+
         private static bool IsManagedAssembly(string fileName)
         {
             try
@@ -2121,17 +2418,48 @@ namespace SHVDN
                 return null;
             }
 
-            string filename = Directory
-                .GetFiles(CurrentDomain.ScriptPath, "*.dll", SearchOption.AllDirectories)
-                .FirstOrDefault(x => x.EndsWith(assemblyName.Name + ".dll", StringComparison.OrdinalIgnoreCase));
-            if (filename != null)
+            if (CurrentDomain.GetDependencyPaths().TryGetValue(assemblyName.Name, out string filename))
             {
-                return Assembly.LoadFrom(filename);
+                return Assembly.LoadFrom(CurrentDomain._assemblyCache.GetShadowCopyPath(filename));
             }
 
             return null;
         }
 
+        /// <summary>
+        /// Gets the assembly files in the scripts directory and its subdirectories by their file name without extension.
+        /// Probing is disabled, so every dependency load goes through <see cref="HandleResolve"/>, and the directory is
+        /// only scanned once per domain instead of on every resolve.
+        /// </summary>
+        private Dictionary<string, string> GetDependencyPaths()
+        {
+            Dictionary<string, string> dependencyPaths = Volatile.Read(ref _dependencyPaths);
+            if (dependencyPaths != null)
+            {
+                return dependencyPaths;
+            }
+
+            dependencyPaths = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+            try
+            {
+                foreach (string filename in Directory.GetFiles(ScriptPath, "*.dll", SearchOption.AllDirectories))
+                {
+                    // Keep the first match, like the previous search did
+                    string name = Path.GetFileNameWithoutExtension(filename);
+                    if (!dependencyPaths.ContainsKey(name))
+                    {
+                        dependencyPaths.Add(name, filename);
+                    }
+                }
+            }
+            catch (Exception ex) when (ex is IOException || ex is UnauthorizedAccessException)
+            {
+                Log.Message(Log.Level.Warning, "Failed to list the assemblies in the scripts directory: ", ex.Message);
+            }
+
+            return Interlocked.CompareExchange(ref _dependencyPaths, dependencyPaths, null) ?? dependencyPaths;
+        }
+
         internal static void HandleUnhandledException(object sender, UnhandledExceptionEventArgs args)
         {
             Log.Message(Log.Level.Error, $"Caught unhandled exception:", Environment.NewLine, args.ExceptionObject.ToString());
@@ -2141,6 +2469,7 @@ namespace SHVDN
                 return;
             }
 
+            script.Metrics.RecordException();
             Log.Message(Log.Level.Error, $"The exception was thrown while executing the script {script.Name} from \"{script.Filename}\".");
 
             if (GetScriptAttribute(script.ScriptInstance.GetType(), "SupportURL") is string supportURL)
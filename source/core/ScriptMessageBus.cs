@@ -0,0 +1,544 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// A registry of named, typed channels scripts in the same script domain can publish messages to and subscribe to.
+    /// </summary>
+    /// <remarks>
+    /// Each channel stores published messages in a ring buffer and each subscription reads from it with its own cursor,
+    /// so publishing never waits for subscribers and never allocates. Messages are delivered in batches at the start of
+    /// the tick of each subscribing script (right after its keyboard events), on the thread that runs the script.
+    /// Publishing is safe from any thread.
+    /// </remarks>
+    internal sealed class ScriptMessageBus
+    {
+        internal const int MaxChannelCapacity = 1 << 30;
+
+        private readonly object _lock = new();
+        private readonly Dictionary<string, ScriptMessageChannel> _channels = new();
+
+        /// <summary>
+        /// Creates a channel owned by a script, or takes over a channel that has no owner yet (because only subscribers
+        /// have used it so far) or anymore (because its previous owner was aborted).
+        /// </summary>
+        /// <param name="owner">The script that owns the channel. The channel is closed when this script is aborted.</param>
+        /// <param name="name">The name of the channel.</param>
+        /// <param name="capacity">The minimum number of messages the channel can buffer for each subscriber.</param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="capacity"/> is not positive or greater than 2^30.</exception>
+        /// <exception cref="ArgumentException">
+        /// Another running script owns a channel with the same name, or the existing channel has a different message type.
+        /// </exception>
+        internal ScriptMessageChannel<T> CreateChannel<T>(Script owner, string name, int capacity)
+        {
+            if (owner == null)
+            {
+                throw new ArgumentNullException(nameof(owner));
+            }
+            ValidateCapacity(capacity);
+
+            lock (_lock)
+            {
+                ScriptMessageChannel<T> channel = GetOrAddChannel<T>(name);
+
+                if (channel.IsDomainChannel)
+                {
+                    throw new ArgumentException($"The channel \"{name}\" is reserved by ScriptHookVDotNet.", nameof(name));
+                }
+
+                Script currentOwner = channel.Owner;
+                if (currentOwner != null && currentOwner.IsRunning)
+                {
+                    throw new ArgumentException($"The channel \"{name}\" is already owned by the script {currentOwner.Name}.", nameof(name));
+                }
+
+                channel.Open(owner, capacity);
+                return channel;
+            }
+        }
+
+        /// <summary>
+        /// Creates a channel the script domain itself publishes to, which no script can take over and which is never closed.
+        /// </summary>
+        /// <param name="name">The name of the channel.</param>
+        /// <param name="capacity">The minimum number of messages the channel can buffer for each subscriber.</param>
+        internal ScriptMessageChannel<T> CreateDomainChannel<T>(string name, int capacity)
+        {
+            ValidateCapacity(capacity);
+
+            lock (_lock)
+            {
+                ScriptMessageChannel<T> channel = GetOrAddChannel<T>(name);
+                channel.Open(null, capacity);
+                return channel;
+            }
+        }
+
+        private static void ValidateCapacity(int capacity)
+        {
+            // The buffer size is the capacity rounded up to a power of two, which must still fit in an int
+            if (capacity <= 0 || capacity > MaxChannelCapacity)
+            {
+                throw new ArgumentOutOfRangeException(nameof(capacity), $"The capacity must be between 1 and {MaxChannelCapacity}.");
+            }
+        }
+
+        /// <summary>
+        /// Subscribes a script to a channel, creating the channel without an owner if it does not exist yet.
+        /// </summary>
+        /// <param name="subscriber">The script the messages are delivered to.</param>
+        /// <param name="name">The name of the channel.</param>
+        /// <param name="handler">The method that is called with each message.</param>
+        /// <exception cref="ArgumentException">The existing channel has a different message type.</exception>
+        internal ScriptMessageSubscription Subscribe<T>(Script subscriber, string name, Action<T> handler)
+        {
+            if (subscriber == null)
+            {
+                throw new ArgumentNullException(nameof(subscriber));
+            }
+            if (handler == null)
+            {
+                throw new ArgumentNullException(nameof(handler));
+            }
+
+            ScriptMessageSubscription<T> subscription;
+            lock (_lock)
+            {
+                ScriptMessageChannel<T> channel = GetOrAddChannel<T>(name);
+                subscription = new ScriptMessageSubscription<T>(this, channel, subscriber, handler);
+                channel.AddSubscription(subscription);
+            }
+
+            subscriber.AddMessageSubscription(subscription);
+            return subscription;
+        }
+
+        /// <summary>
+        /// Closes the channels the script owns and cancels its subscriptions.
+        /// </summary>
+        internal void OnScriptAborted(Script script)
+        {
+            lock (_lock)
+            {
+                foreach (ScriptMessageChannel channel in _channels.Values)
+                {
+                    if (channel.Owner == script)
+                    {
+                        channel.Close();
+                    }
+                }
+            }
+
+            foreach (ScriptMessageSubscription subscription in script.MessageSubscriptions)
+            {
+                subscription.Dispose();
+            }
+        }
+
+        internal void Unsubscribe(ScriptMessageSubscription subscription)
+        {
+            lock (_lock)
+            {
+                ScriptMessageChannel channel = subscription.Channel;
+                channel.RemoveSubscription(subscription);
+
+                // Forget channels nobody uses anymore, so the names of unloaded scripts do not pile up
+                if (channel.Owner == null && !channel.IsDomainChannel && channel.SubscriptionCount == 0)
+                {
+                    _channels.Remove(channel.Name);
+                }
+            }
+
+            subscription.Subscriber.RemoveMessageSubscription(subscription);
+        }
+
+        private ScriptMessageChannel<T> GetOrAddChannel<T>(string name)
+        {
+            if (string.IsNullOrEmpty(name))
+            {
+                throw new ArgumentException("The channel name must not be null or empty.", nameof(name));
+            }
+
+            if (!_channels.TryGetValue(name, out ScriptMessageChannel channel))
+            {
+                var newChannel = new ScriptMessageChannel<T>(name);
+                _channels.Add(name, newChannel);
+                return newChannel;
+            }
+
+            if (channel is not ScriptMessageChannel<T> typedChannel)
+            {
+                throw new ArgumentException($"The channel \"{name}\" carries messages of type {channel.MessageType.FullName}, not {typeof(T).FullName}.", nameof(name));
+            }
+
+            return typedChannel;
+        }
+    }
+
+    /// <summary>
+    /// A named channel of a <see cref="ScriptMessageBus"/>.
+    /// </summary>
+    public abstract class ScriptMessageChannel
+    {
+        private protected readonly object _lock = new();
+        private protected ScriptMessageSubscription[] _subscriptions = Array.Empty<ScriptMessageSubscription>();
+        private protected Script _owner;
+        private protected bool _isOpen;
+
+        private protected ScriptMessageChannel(string name)
+        {
+            Name = name;
+        }
+
+        /// <summary>
+        /// Gets the name of this channel.
+        /// </summary>
+        public string Name { get; }
+        /// <summary>
+        /// Gets the type of the messages of this channel.
+        /// </summary>
+        public abstract Type MessageType { get; }
+
+        /// <summary>
+        /// Gets the script that publishes to this channel, or <see langword="null" /> if there is none at the moment.
+        /// </summary>
+        public Script Owner
+        {
+            get
+            {
+                lock (_lock)
+                {
+                    return _owner;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets whether the script domain publishes to this channel instead of a script.
+        /// </summary>
+        internal bool IsDomainChannel
+        {
+            get
+            {
+                lock (_lock)
+                {
+                    return _isOpen && _owner == null;
+                }
+            }
+        }
+
+        internal int SubscriptionCount
+        {
+            get
+            {
+                lock (_lock)
+                {
+                    return _subscriptions.Length;
+                }
+            }
+        }
+
+        internal void AddSubscription(ScriptMessageSubscription subscription)
+        {
+            lock (_lock)
+            {
+                subscription.OnAdded();
+
+                var subscriptions = new ScriptMessageSubscription[_subscriptions.Length + 1];
+                Array.Copy(_subscriptions, subscriptions, _subscriptions.Length);
+                subscriptions[subscriptions.Length - 1] = subscription;
+                _subscriptions = subscriptions;
+            }
+        }
+        internal void RemoveSubscription(ScriptMessageSubscription subscription)
+        {
+            lock (_lock)
+            {
+                int index = Array.IndexOf(_subscriptions, subscription);
+                if (index < 0)
+                {
+                    return;
+                }
+
+                var subscriptions = new ScriptMessageSubscription[_subscriptions.Length - 1];
+                Array.Copy(_subscriptions, 0, subscriptions, 0, index);
+                Array.Copy(_subscriptions, index + 1, subscriptions, index, subscriptions.Length - index);
+                _subscriptions = subscriptions;
+            }
+        }
+
+        /// <summary>
+        /// Drops all buffered messages and detaches the owner. Subscriptions stay, so they receive messages again
+        /// once another script takes over the channel.
+        /// </summary>
+        internal abstract void Close();
+    }
+
+    /// <summary>
+    /// A named channel of a <see cref="ScriptMessageBus"/> that carries messages of type <typeparamref name="T"/>.
+    /// </summary>
+    /// <remarks>
+    /// Messages are copied into a ring buffer, so value types are published without any allocation.
+    /// Reference types are supported for cold paths, but the buffer keeps them alive until they are overwritten or the
+    /// channel is closed.
+    /// </remarks>
+    public sealed class ScriptMessageChannel<T> : ScriptMessageChannel
+    {
+        private T[] _buffer = Array.Empty<T>();
+        private int _mask;
+        private long _writeSequence;
+
+        internal ScriptMessageChannel(string name) : base(name)
+        {
+        }
+
+        /// <inheritdoc/>
+        public override Type MessageType => typeof(T);
+
+        /// <summary>
+        /// Gets the number of messages this channel can buffer for each subscriber. A subscriber that falls further
+        /// behind loses the oldest messages.
+        /// </summary>
+        public int Capacity
+        {
+            get
+            {
+                lock (_lock)
+                {
+                    return _buffer.Length;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets whether this channel currently has an owner (or is published to by the script domain) and thus accepts messages.
+        /// </summary>
+        public bool IsOpen
+        {
+            get
+            {
+                lock (_lock)
+                {
+                    return _isOpen;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Publishes a message to all subscriptions of this channel. Can be called from any thread.
+        /// </summary>
+        /// <returns><see langword="true" /> if the message was published; <see langword="false" /> if the channel is closed.</returns>
+        public bool Publish(T message)
+        {
+            lock (_lock)
+            {
+                if (!_isOpen)
+                {
+                    return false;
+                }
+
+                // Skip the buffer entirely if nobody listens
+                if (_subscriptions.Length != 0)
+                {
+                    _buffer[(int)_writeSequence & _mask] = message;
+                    _writeSequence++;
+                }
+
+                return true;
+            }
+        }
+
+        internal void Open(Script owner, int capacity)
+        {
+            // Round up to a power of two so the sequence can be masked instead of divided
+            int bufferSize = 1;
+            while (bufferSize < capacity)
+            {
+                bufferSize <<= 1;
+            }
+
+            lock (_lock)
+            {
+                if (_buffer.Length != bufferSize)
+                {
+                    _buffer = new T[bufferSize];
+                    _mask = bufferSize - 1;
+                }
+
+                _owner = owner;
+                _isOpen = true;
+            }
+        }
+
+        internal override void Close()
+        {
+            lock (_lock)
+            {
+                _owner = null;
+                _isOpen = false;
+
+                // Release references held by the buffer and let all subscriptions skip what they have not read yet
+                Array.Clear(_buffer, 0, _buffer.Length);
+                foreach (ScriptMessageSubscription subscription in _subscriptions)
+                {
+                    ((ScriptMessageSubscription<T>)subscription).SkipTo(_writeSequence);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Copies the messages after <paramref name="readSequence"/> into <paramref name="batch"/>.
+        /// </summary>
+        /// <returns>The number of copied messages.</returns>
+        internal int Read(ref long readSequence, ref T[] batch, out long droppedCount)
+        {
+            lock (_lock)
+            {
+                long availableCount = _writeSequence - readSequence;
+                droppedCount = 0;
+                if (availableCount <= 0)
+                {
+                    return 0;
+                }
+
+                if (availableCount > _buffer.Length)
+                {
+                    droppedCount = availableCount - _buffer.Length;
+                    availableCount = _buffer.Length;
+                    readSequence = _writeSequence - availableCount;
+                }
+
+                if (batch.Length < _buffer.Length)
+                {
+                    // Only happens once per subscription (or when the channel gets bigger), not per message
+                    batch = new T[_buffer.Length];
+                }
+
+                int count = (int)availableCount;
+                int start = (int)readSequence & _mask;
+                int firstPartCount = Math.Min(count, _buffer.Length - start);
+                Array.Copy(_buffer, start, batch, 0, firstPartCount);
+                Array.Copy(_buffer, 0, batch, firstPartCount, count - firstPartCount);
+
+                readSequence = _writeSequence;
+                return count;
+            }
+        }
+
+        internal long WriteSequence => _writeSequence;
+    }
+
+    /// <summary>
+    /// A subscription of a script to a <see cref="ScriptMessageChannel"/>. Dispose it to unsubscribe.
+    /// </summary>
+    public abstract class ScriptMessageSubscription : IDisposable
+    {
+        private readonly ScriptMessageBus _bus;
+        private long _droppedMessageCount;
+        private int _isDisposed;
+
+        private protected ScriptMessageSubscription(ScriptMessageBus bus, ScriptMessageChannel channel, Script subscriber)
+        {
+            _bus = bus;
+            Channel = channel;
+            Subscriber = subscriber;
+        }
+
+        /// <summary>
+        /// Gets the channel of this subscription.
+        /// </summary>
+        public ScriptMessageChannel Channel { get; }
+        /// <summary>
+        /// Gets the script the messages are delivered to.
+        /// </summary>
+        public Script Subscriber { get; }
+
+        /// <summary>
+        /// Gets the number of messages that were overwritten before they could be delivered.
+        /// </summary>
+        public long DroppedMessageCount => Interlocked.Read(ref _droppedMessageCount);
+
+        /// <summary>
+        /// Unsubscribes from the channel. Messages that have not been delivered yet are dropped.
+        /// </summary>
+        public void Dispose()
+        {
+            if (Interlocked.Exchange(ref _isDisposed, 1) != 0)
+            {
+                return;
+            }
+
+            _bus.Unsubscribe(this);
+        }
+
+        private protected void AddDroppedMessages(long count)
+        {
+            Interlocked.Add(ref _droppedMessageCount, count);
+        }
+
+        /// <summary>
+        /// Called by the channel with its lock held when the subscription is added.
+        /// </summary>
+        internal abstract void OnAdded();
+
+        /// <summary>
+        /// Calls the handler with all messages published since the last delivery. Must be called on the thread of the subscriber.
+        /// </summary>
+        internal abstract void Deliver();
+    }
+
+    internal sealed class ScriptMessageSubscription<T> : ScriptMessageSubscription
+    {
+        private readonly ScriptMessageChannel<T> _channel;
+        private readonly Action<T> _handler;
+        private long _readSequence;
+        private T[] _batch = Array.Empty<T>();
+
+        internal ScriptMessageSubscription(ScriptMessageBus bus, ScriptMessageChannel<T> channel, Script subscriber, Action<T> handler)
+            : base(bus, channel, subscriber)
+        {
+            _channel = channel;
+            _handler = handler;
+        }
+
+        internal override void OnAdded()
+        {
+            // Only deliver messages published from now on
+            _readSequence = _channel.WriteSequence;
+        }
+
+        internal void SkipTo(long sequence)
+        {
+            _readSequence = sequence;
+        }
+
+        internal override void Deliver()
+        {
+            int count = _channel.Read(ref _readSequence, ref _batch, out long droppedCount);
+            if (droppedCount != 0)
+            {
+                AddDroppedMessages(droppedCount);
+            }
+
+            try
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    _handler(_batch[i]);
+                }
+            }
+            finally
+            {
+                // Do not keep references alive until the next delivery
+                Array.Clear(_batch, 0, count);
+            }
+        }
+    }
+}
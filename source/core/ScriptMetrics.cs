@@ -0,0 +1,329 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Diagnostics;
+using System.Reflection;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// Collects the execution metrics of a <see cref="Script"/>.
+    /// </summary>
+    /// <remarks>
+    /// The script domain measures the wall time of each tick with <see cref="Stopwatch"/>. The CPU time, allocated
+    /// bytes and native calls are measured on the thread that runs the script, in slices that start when the script
+    /// is resumed and end when it yields back to the domain.
+    /// Recording a tick only takes a few counter reads, so the collection is always enabled.
+    /// </remarks>
+    internal sealed class ScriptMetrics
+    {
+        private struct TickSample
+        {
+            internal long _wallTime;
+            internal long _cpuTime;
+            internal long _allocatedBytes;
+            internal long _nativeCallCount;
+        }
+
+        private const int SampleWindowSize = 256;
+
+        [ThreadStatic]
+        private static long s_nativeCallCount;
+
+        private static readonly Func<long> s_getAllocatedBytes = CreateAllocatedBytesGetter(out s_isAllocatedBytesPerThread);
+        private static readonly bool s_isAllocatedBytesPerThread;
+
+        private readonly object _lock = new();
+        private readonly TickSample[] _samples = new TickSample[SampleWindowSize];
+        private int _nextSampleIndex;
+        private int _sampleCount;
+        private TickSample _windowSum;
+        private TickSample _total;
+        private long _tickCount;
+        private int _exceptionCount;
+
+        // Only accessed by the thread that currently runs the script, the semaphores of the script domain make the
+        // values visible to the main thread when the script yields
+        private bool _isSliceActive;
+        private long _sliceCpuTimeStart;
+        private long _sliceAllocatedBytesStart;
+        private long _sliceNativeCallCountStart;
+        private TickSample _pending;
+
+        [DllImport("kernel32.dll")]
+        private static extern IntPtr GetCurrentThread();
+
+        [DllImport("kernel32.dll")]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        private static extern bool GetThreadTimes(IntPtr hThread, out long creationTime, out long exitTime, out long kernelTime, out long userTime);
+
+        /// <summary>
+        /// Counts native calls for the metrics of the script the current thread is running.
+        /// </summary>
+        internal static void CountNativeCalls(int count)
+        {
+            s_nativeCallCount += count;
+        }
+
+        /// <summary>
+        /// Starts measuring the work done on the current thread for the current tick.
+        /// </summary>
+        internal void BeginSlice()
+        {
+            _isSliceActive = true;
+            _sliceCpuTimeStart = GetCurrentThreadCpuTime();
+            _sliceAllocatedBytesStart = s_getAllocatedBytes();
+            _sliceNativeCallCountStart = s_nativeCallCount;
+        }
+        /// <summary>
+        /// Stops measuring the work done on the current thread and adds it to the current tick.
+        /// </summary>
+        internal void EndSlice()
+        {
+            if (!_isSliceActive)
+            {
+                return;
+            }
+
+            _isSliceActive = false;
+            _pending._cpuTime += GetCurrentThreadCpuTime() - _sliceCpuTimeStart;
+            _pending._allocatedBytes += s_getAllocatedBytes() - _sliceAllocatedBytesStart;
+            _pending._nativeCallCount += s_nativeCallCount - _sliceNativeCallCountStart;
+        }
+
+        /// <summary>
+        /// Records a tick with the slices measured since the last tick. Must be called while the script is not running.
+        /// </summary>
+        /// <param name="wallTime">The elapsed time of the tick in <see cref="Stopwatch"/> ticks.</param>
+        internal void CompleteTick(long wallTime)
+        {
+            TickSample sample = _pending;
+            sample._wallTime = wallTime;
+            _pending = default;
+
+            lock (_lock)
+            {
+                if (_sampleCount == SampleWindowSize)
+                {
+                    Subtract(ref _windowSum, _samples[_nextSampleIndex]);
+                }
+                else
+                {
+                    _sampleCount++;
+                }
+
+                _samples[_nextSampleIndex] = sample;
+                _nextSampleIndex = (_nextSampleIndex + 1) % SampleWindowSize;
+                Add(ref _windowSum, sample);
+                Add(ref _total, sample);
+                _tickCount++;
+            }
+        }
+
+        /// <summary>
+        /// Records an unhandled exception thrown by the script.
+        /// </summary>
+        internal void RecordException()
+        {
+            Interlocked.Increment(ref _exceptionCount);
+        }
+
+        /// <summary>
+        /// Creates a snapshot of the current metrics. The averages and percentiles cover the last 256 ticks.
+        /// </summary>
+        /// <param name="scriptName">The name of the script.</param>
+        /// <param name="filename">The path to the file that contains the script.</param>
+        internal ScriptMetricsSnapshot GetSnapshot(string scriptName, string filename)
+        {
+            var snapshot = new ScriptMetricsSnapshot
+            {
+                ScriptName = scriptName,
+                Filename = filename,
+                ExceptionCount = Volatile.Read(ref _exceptionCount),
+                IsAllocatedBytesPerThread = s_isAllocatedBytesPerThread,
+            };
+
+            long[] wallTimes;
+            lock (_lock)
+            {
+                snapshot.TickCount = _tickCount;
+                snapshot.TotalCpuTime = new TimeSpan(_total._cpuTime);
+                snapshot.TotalAllocatedBytes = _total._allocatedBytes;
+                snapshot.TotalNativeCallCount = _total._nativeCallCount;
+
+                if (_sampleCount == 0)
+                {
+                    return snapshot;
+                }
+
+                TickSample last = _samples[(_nextSampleIndex + SampleWindowSize - 1) % SampleWindowSize];
+                snapshot.LastTickTime = StopwatchTicksToTimeSpan(last._wallTime);
+                snapshot.LastCpuTime = new TimeSpan(last._cpuTime);
+                snapshot.LastAllocatedBytes = last._allocatedBytes;
+                snapshot.LastNativeCallCount = last._nativeCallCount;
+
+                snapshot.AverageTickTime = StopwatchTicksToTimeSpan(_windowSum._wallTime / _sampleCount);
+                snapshot.AverageCpuTime = new TimeSpan(_windowSum._cpuTime / _sampleCount);
+                snapshot.AverageAllocatedBytes = _windowSum._allocatedBytes / _sampleCount;
+                snapshot.AverageNativeCallCount = (double)_windowSum._nativeCallCount / _sampleCount;
+
+                wallTimes = new long[_sampleCount];
+                for (int i = 0; i < _sampleCount; i++)
+                {
+                    wallTimes[i] = _samples[i]._wallTime;
+                }
+            }
+
+            // Sort outside of the lock, the script domain should never wait for someone reading the metrics
+            Array.Sort(wallTimes);
+            int p99Index = Math.Max(0, (int)Math.Ceiling(wallTimes.Length * 0.99) - 1);
+            snapshot.P99TickTime = StopwatchTicksToTimeSpan(wallTimes[p99Index]);
+
+            return snapshot;
+        }
+
+        private static void Add(ref TickSample sum, TickSample sample)
+        {
+            sum._wallTime += sample._wallTime;
+            sum._cpuTime += sample._cpuTime;
+            sum._allocatedBytes += sample._allocatedBytes;
+            sum._nativeCallCount += sample._nativeCallCount;
+        }
+        private static void Subtract(ref TickSample sum, TickSample sample)
+        {
+            sum._wallTime -= sample._wallTime;
+            sum._cpuTime -= sample._cpuTime;
+            sum._allocatedBytes -= sample._allocatedBytes;
+            sum._nativeCallCount -= sample._nativeCallCount;
+        }
+
+        private static TimeSpan StopwatchTicksToTimeSpan(long stopwatchTicks)
+        {
+            return new TimeSpan((long)(stopwatchTicks * ((double)TimeSpan.TicksPerSecond / Stopwatch.Frequency)));
+        }
+
+        /// <summary>
+        /// Gets the user and kernel time of the current thread in 100-nanosecond units.
+        /// </summary>
+        private static long GetCurrentThreadCpuTime()
+        {
+            return GetThreadTimes(GetCurrentThread(), out _, out _, out long kernelTime, out long userTime) ? kernelTime + userTime : 0;
+        }
+
+        private static Func<long> CreateAllocatedBytesGetter(out bool isPerThread)
+        {
+            // .NET Framework runtimes do not always provide the per thread counter, so look it up instead of binding to it
+            MethodInfo perThreadMethod = typeof(GC).GetMethod("GetAllocatedBytesForCurrentThread", BindingFlags.Public | BindingFlags.Static, null, Type.EmptyTypes, null);
+            if (perThreadMethod != null)
+            {
+                isPerThread = true;
+                return (Func<long>)Delegate.CreateDelegate(typeof(Func<long>), perThreadMethod);
+            }
+
+            isPerThread = false;
+            try
+            {
+                AppDomain.MonitoringIsEnabled = true;
+            }
+            catch (Exception ex)
+            {
+                Log.Message(Log.Level.Warning, "Failed to enable AppDomain resource monitoring, allocated bytes of scripts will not be available: ", ex.ToString());
+                return () => 0;
+            }
+
+            return () => AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+        }
+    }
+
+    /// <summary>
+    /// A snapshot of the <see cref="ScriptMetrics"/> of a script.
+    /// </summary>
+    [Serializable]
+    public sealed class ScriptMetricsSnapshot
+    {
+        /// <summary>
+        /// Gets the name of the script.
+        /// </summary>
+        public string ScriptName { get; internal set; }
+        /// <summary>
+        /// Gets the path to the file that contains the script.
+        /// </summary>
+        public string Filename { get; internal set; }
+
+        /// <summary>
+        /// Gets the number of ticks the script has executed.
+        /// </summary>
+        public long TickCount { get; internal set; }
+        /// <summary>
+        /// Gets the number of unhandled exceptions the script has thrown.
+        /// </summary>
+        public int ExceptionCount { get; internal set; }
+
+        /// <summary>
+        /// Gets the wall time of the last tick, including the time spent in native calls.
+        /// </summary>
+        public TimeSpan LastTickTime { get; internal set; }
+        /// <summary>
+        /// Gets the average wall time of the recent ticks.
+        /// </summary>
+        public TimeSpan AverageTickTime { get; internal set; }
+        /// <summary>
+        /// Gets the 99th percentile of the wall time of the recent ticks.
+        /// </summary>
+        public TimeSpan P99TickTime { get; internal set; }
+
+        /// <summary>
+        /// Gets the CPU time the thread of the script used in the last tick.
+        /// </summary>
+        /// <remarks>
+        /// The OS only updates thread times on clock interrupts, so the value for a single tick is coarse.
+        /// Prefer <see cref="AverageCpuTime"/> and <see cref="TotalCpuTime"/>.
+        /// </remarks>
+        public TimeSpan LastCpuTime { get; internal set; }
+        /// <summary>
+        /// Gets the average CPU time the thread of the script used in the recent ticks.
+        /// </summary>
+        public TimeSpan AverageCpuTime { get; internal set; }
+        /// <summary>
+        /// Gets the total CPU time the thread of the script used in its ticks.
+        /// </summary>
+        public TimeSpan TotalCpuTime { get; internal set; }
+
+        /// <summary>
+        /// Gets whether the allocated bytes are counted per thread. If <see langword="false" />, the allocations of
+        /// the whole script domain during the ticks of the script are counted, which includes allocations of threads
+        /// the script does not own.
+        /// </summary>
+        public bool IsAllocatedBytesPerThread { get; internal set; }
+        /// <summary>
+        /// Gets the number of bytes allocated in the last tick.
+        /// </summary>
+        public long LastAllocatedBytes { get; internal set; }
+        /// <summary>
+        /// Gets the average number of bytes allocated in the recent ticks.
+        /// </summary>
+        public long AverageAllocatedBytes { get; internal set; }
+        /// <summary>
+        /// Gets the total number of bytes allocated in the ticks of the script.
+        /// </summary>
+        public long TotalAllocatedBytes { get; internal set; }
+
+        /// <summary>
+        /// Gets the number of native calls in the last tick.
+        /// </summary>
+        public long LastNativeCallCount { get; internal set; }
+        /// <summary>
+        /// Gets the average number of native calls in the recent ticks.
+        /// </summary>
+        public double AverageNativeCallCount { get; internal set; }
+        /// <summary>
+        /// Gets the total number of native calls in the ticks of the script.
+        /// </summary>
+        public long TotalNativeCallCount { get; internal set; }
+    }
+}
@@ -0,0 +1,628 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace SHVDN
+{
+    /// <summary>
+    /// The kinds of streaming assets the <see cref="StreamingRequestManager"/> can load.
+    /// </summary>
+    public enum StreamingAssetType
+    {
+        Model,
+        ClipSet,
+        ClipDictionary,
+        ParticleEffectAsset,
+        TextureDictionary,
+    }
+
+    /// <summary>
+    /// The shared request for one streaming asset, which all scripts that requested the asset hold together.
+    /// </summary>
+    public sealed class StreamingRequest
+    {
+        private const int StatePending = 0;
+        private const int StateLoaded = 1;
+        private const int StateFailed = 2;
+
+        internal struct Callback
+        {
+            internal Script _script;
+            internal Action<bool> _handler;
+            internal Action _continuation;
+        }
+
+        private readonly StreamingRequestManager _manager;
+        private volatile int _state;
+
+        // These are guarded by the lock of the manager
+        internal readonly List<Script> _holders = new();
+        internal readonly List<Callback> _callbacks = new();
+        internal IntPtr _nativeName;
+        internal long _requestTimestamp;
+        internal long _prefetchDeadline;
+        internal bool _hasBeenPolled;
+
+        internal StreamingRequest(StreamingRequestManager manager, StreamingAssetType assetType, int hash, string name)
+        {
+            _manager = manager;
+            AssetType = assetType;
+            Hash = hash;
+            Name = name;
+        }
+
+        /// <summary>
+        /// Gets the kind of the asset.
+        /// </summary>
+        public StreamingAssetType AssetType { get; }
+        /// <summary>
+        /// Gets the model hash of the asset. Only used for <see cref="StreamingAssetType.Model"/>.
+        /// </summary>
+        public int Hash { get; }
+        /// <summary>
+        /// Gets the name of the asset. Not used for <see cref="StreamingAssetType.Model"/>.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        /// Gets whether the asset has either been loaded or failed to load.
+        /// </summary>
+        public bool IsCompleted => _state != StatePending;
+        /// <summary>
+        /// Gets whether the asset has been loaded.
+        /// </summary>
+        public bool IsLoaded => _state == StateLoaded;
+        /// <summary>
+        /// Gets whether the asset does not exist and cannot be loaded.
+        /// </summary>
+        public bool IsFailed => _state == StateFailed;
+
+        /// <summary>
+        /// Gets the number of scripts that hold this request.
+        /// </summary>
+        public int HolderCount
+        {
+            get
+            {
+                lock (_manager._lock)
+                {
+                    return _holders.Count;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the time it took from the first request to the asset being loaded, or <see cref="TimeSpan.Zero"/> if it
+        /// was not loaded by this request.
+        /// </summary>
+        public TimeSpan LoadTime { get; private set; }
+
+        /// <summary>
+        /// Registers a method that is called with whether the asset was loaded once the request completes.
+        /// The method is called at the start of the next tick of the executing script, on the thread that runs it,
+        /// even if the request has already completed.
+        /// </summary>
+        /// <exception cref="InvalidOperationException">No script is executing.</exception>
+        public void OnCompleted(Action<bool> handler)
+        {
+            if (handler == null)
+            {
+                throw new ArgumentNullException(nameof(handler));
+            }
+
+            _manager.AddCallback(this, new Callback { _script = StreamingRequestManager.GetExecutingScript(), _handler = handler });
+        }
+
+        public StreamingRequestAwaiter GetAwaiter() => new(this);
+
+        internal void AddContinuation(Action continuation)
+        {
+            _manager.AddCallback(this, new Callback { _script = StreamingRequestManager.GetExecutingScript(), _continuation = continuation });
+        }
+
+        internal void Complete(bool loaded, long timestamp)
+        {
+            if (loaded && _requestTimestamp != 0)
+            {
+                LoadTime = TimeSpan.FromSeconds((double)(timestamp - _requestTimestamp) / Stopwatch.Frequency);
+            }
+
+            _state = loaded ? StateLoaded : StateFailed;
+
+            foreach (Callback callback in _callbacks)
+            {
+                callback._script.EnqueueStreamingCompletion(new StreamingCompletion(callback, loaded));
+            }
+            _callbacks.Clear();
+        }
+
+        /// <summary>
+        /// Sets a loaded request back to pending after the asset was unloaded by something other than the manager.
+        /// </summary>
+        internal void Restart(long timestamp)
+        {
+            _requestTimestamp = timestamp;
+            LoadTime = TimeSpan.Zero;
+            _state = StatePending;
+        }
+    }
+
+    /// <summary>
+    /// Allows scripts to <see langword="await"/> a <see cref="StreamingRequest"/>. The continuation runs at the start of
+    /// the next tick of the awaiting script once the request completes.
+    /// </summary>
+    public readonly struct StreamingRequestAwaiter : INotifyCompletion
+    {
+        private readonly StreamingRequest _request;
+
+        internal StreamingRequestAwaiter(StreamingRequest request)
+        {
+            _request = request;
+        }
+
+        public bool IsCompleted => _request.IsCompleted;
+
+        public bool GetResult() => _request.IsLoaded;
+
+        public void OnCompleted(Action continuation)
+        {
+            _request.AddContinuation(continuation);
+        }
+    }
+
+    /// <summary>
+    /// A completion of a <see cref="StreamingRequest"/> waiting to be delivered to a script.
+    /// </summary>
+    internal readonly struct StreamingCompletion
+    {
+        private readonly Action<bool> _handler;
+        private readonly Action _continuation;
+        private readonly bool _loaded;
+
+        internal StreamingCompletion(StreamingRequest.Callback callback, bool loaded)
+        {
+            _handler = callback._handler;
+            _continuation = callback._continuation;
+            _loaded = loaded;
+        }
+
+        internal void Invoke()
+        {
+            if (_continuation != null)
+            {
+                _continuation();
+            }
+            else
+            {
+                _handler(_loaded);
+            }
+        }
+    }
+
+    /// <summary>
+    /// A snapshot of the state of the <see cref="StreamingRequestManager"/>.
+    /// </summary>
+    public sealed class StreamingStatisticsSnapshot
+    {
+        /// <summary>
+        /// Gets the number of assets that have been requested but are not loaded yet.
+        /// </summary>
+        public int QueueDepth { get; internal set; }
+        /// <summary>
+        /// Gets the number of assets that are held by at least one script or prefetched.
+        /// </summary>
+        public int RequestCount { get; internal set; }
+        /// <summary>
+        /// Gets the number of assets that have been loaded since the script domain started.
+        /// </summary>
+        public long CompletedLoadCount { get; internal set; }
+        /// <summary>
+        /// Gets the number of assets that failed to load since the script domain started.
+        /// </summary>
+        public long FailedLoadCount { get; internal set; }
+        /// <summary>
+        /// Gets the average time it took to load an asset.
+        /// </summary>
+        public TimeSpan AverageLoadTime { get; internal set; }
+        /// <summary>
+        /// Gets the longest time it took to load an asset.
+        /// </summary>
+        public TimeSpan MaxLoadTime { get; internal set; }
+    }
+
+    /// <summary>
+    /// Loads streaming assets on behalf of all scripts in a script domain.
+    /// </summary>
+    /// <remarks>
+    /// Requests for the same asset are merged into one <see cref="StreamingRequest"/>, which the script domain polls once
+    /// per frame before any script ticks, no matter how many scripts wait for it. Each script holds a request at most
+    /// once, and the asset is only marked as no longer needed after the last script released it (or was aborted), so
+    /// scripts can no longer unload assets other scripts still use.
+    /// Prefetched assets are loaded without a holder and are released again if no script picks them up in time.
+    /// Loaded assets are still polled every frame and requested again if something else unloaded them.
+    /// </remarks>
+    internal sealed class StreamingRequestManager
+    {
+        private const ulong IsModelInCdImageHash = 0x35B9E0803292B641;
+        private const ulong DoesAnimDictExistHash = 0x2DA49C3B79856961;
+
+        private static readonly ulong[] s_requestHashes =
+        {
+            0x963D27A58DF860AC, // REQUEST_MODEL
+            0xD2A71E1A77418A49, // REQUEST_CLIP_SET
+            0xD3BD40951412FEF6, // REQUEST_ANIM_DICT
+            0xB80D8756B4668AB6, // REQUEST_NAMED_PTFX_ASSET
+            0xDFA2EF8E04127DD5, // REQUEST_STREAMED_TEXTURE_DICT
+        };
+        private static readonly ulong[] s_hasLoadedHashes =
+        {
+            0x98A4EB5D89A0C952, // HAS_MODEL_LOADED
+            0x318234F4F3738AF3, // HAS_CLIP_SET_LOADED
+            0xD031A9162D01088C, // HAS_ANIM_DICT_LOADED
+            0x8702416E512EC454, // HAS_NAMED_PTFX_ASSET_LOADED
+            0x0145F696AAAAD2E4, // HAS_STREAMED_TEXTURE_DICT_LOADED
+        };
+        private static readonly ulong[] s_releaseHashes =
+        {
+            0xE532F5D78798DAAB, // SET_MODEL_AS_NO_LONGER_NEEDED
+            0x01F73A131C18CD94, // REMOVE_CLIP_SET
+            0xF66A602F829E2A06, // REMOVE_ANIM_DICT
+            0x5F61EBBE1A00F96D, // REMOVE_NAMED_PTFX_ASSET
+            0xBE2CACCF5A8AA805, // SET_STREAMED_TEXTURE_DICT_AS_NO_LONGER_NEEDED
+        };
+
+        private readonly struct AssetKey : IEquatable<AssetKey>
+        {
+            private readonly StreamingAssetType _type;
+            private readonly int _hash;
+            private readonly string _name;
+
+            internal AssetKey(StreamingAssetType type, int hash, string name)
+            {
+                _type = type;
+                _hash = hash;
+                _name = name;
+            }
+
+            // The game identifies named assets by joaat hashes, which ignore case
+            public bool Equals(AssetKey other) => _type == other._type && _hash == other._hash && string.Equals(_name, other._name, StringComparison.OrdinalIgnoreCase);
+            public override bool Equals(object obj) => obj is AssetKey other && Equals(other);
+            public override int GetHashCode() => ((int)_type * 397) ^ (_name != null ? StringComparer.OrdinalIgnoreCase.GetHashCode(_name) : _hash);
+        }
+
+        internal readonly object _lock = new();
+        private readonly Dictionary<AssetKey, StreamingRequest> _requestsByKey = new();
+        private readonly List<StreamingRequest> _requests = new();
+
+        private long _completedLoadCount;
+        private long _failedLoadCount;
+        private long _totalLoadTicks;
+        private long _maxLoadTicks;
+
+        /// <summary>
+        /// Adds the executing script as a holder of an asset and starts loading the asset if nobody requested it yet.
+        /// Holding an asset that is already held by the script does nothing.
+        /// </summary>
+        /// <returns>The request for the asset, or <see langword="null" /> if no script is executing.</returns>
+        internal StreamingRequest Acquire(StreamingAssetType assetType, int hash, string name)
+        {
+            Script script = ScriptDomain.ExecutingScript;
+            if (script == null)
+            {
+                return null;
+            }
+
+            lock (_lock)
+            {
+                StreamingRequest request = GetOrAddRequest(assetType, hash, name);
+                if (!request._holders.Contains(script))
+                {
+                    request._holders.Add(script);
+                }
+
+                return request;
+            }
+        }
+
+        /// <summary>
+        /// Removes the executing script from the holders of an asset. The asset is marked as no longer needed in the
+        /// next frame if this was the last holder and the asset is not prefetched.
+        /// </summary>
+        /// <returns>
+        /// <see langword="true" /> if the asset is managed by this instance, in which case the caller must not mark it as
+        /// no longer needed by itself; otherwise, <see langword="false" />.
+        /// </returns>
+        internal bool Release(StreamingAssetType assetType, int hash, string name)
+        {
+            lock (_lock)
+            {
+                if (!_requestsByKey.TryGetValue(new AssetKey(assetType, hash, assetType != StreamingAssetType.Model ? name : null), out StreamingRequest request))
+                {
+                    return false;
+                }
+
+                Script script = ScriptDomain.ExecutingScript;
+                if (script != null)
+                {
+                    request._holders.Remove(script);
+                }
+                else
+                {
+                    // Marking the asset as no longer needed here would unload it under the scripts that hold it
+                    Log.Message(Log.Level.Warning, "Cannot release the streaming asset ", request.Name ?? "0x" + request.Hash.ToString("X8"),
+                        " outside of a script. It stays loaded until the scripts that hold it release it.");
+                }
+
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Starts loading an asset without holding it, so a script can pick it up later without waiting.
+        /// </summary>
+        /// <param name="keepAliveMilliseconds">How long to keep the asset loaded if no script holds it.</param>
+        internal StreamingRequest Prefetch(StreamingAssetType assetType, int hash, string name, int keepAliveMilliseconds)
+        {
+            long deadline = Stopwatch.GetTimestamp() + (long)keepAliveMilliseconds * Stopwatch.Frequency / 1000;
+
+            lock (_lock)
+            {
+                StreamingRequest request = GetOrAddRequest(assetType, hash, name);
+                if (deadline > request._prefetchDeadline)
+                {
+                    request._prefetchDeadline = deadline;
+                }
+
+                return request;
+            }
+        }
+
+        internal StreamingStatisticsSnapshot GetStatistics()
+        {
+            lock (_lock)
+            {
+                int queueDepth = 0;
+                foreach (StreamingRequest request in _requests)
+                {
+                    if (!request.IsCompleted)
+                    {
+                        queueDepth++;
+                    }
+                }
+
+                return new StreamingStatisticsSnapshot
+                {
+                    QueueDepth = queueDepth,
+                    RequestCount = _requests.Count,
+                    CompletedLoadCount = _completedLoadCount,
+                    FailedLoadCount = _failedLoadCount,
+                    AverageLoadTime = _completedLoadCount != 0 ? StopwatchTicksToTimeSpan(_totalLoadTicks / _completedLoadCount) : TimeSpan.Zero,
+                    MaxLoadTime = StopwatchTicksToTimeSpan(_maxLoadTicks),
+                };
+            }
+        }
+
+        internal void AddCallback(StreamingRequest request, StreamingRequest.Callback callback)
+        {
+            lock (_lock)
+            {
+                if (!request.IsCompleted)
+                {
+                    request._callbacks.Add(callback);
+                    return;
+                }
+            }
+
+            callback._script.EnqueueStreamingCompletion(new StreamingCompletion(callback, request.IsLoaded));
+        }
+
+        /// <summary>
+        /// Releases everything the script holds and drops its pending callbacks.
+        /// </summary>
+        internal void OnScriptAborted(Script script)
+        {
+            lock (_lock)
+            {
+                foreach (StreamingRequest request in _requests)
+                {
+                    request._holders.Remove(script);
+                    request._callbacks.RemoveAll(x => x._script == script);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Marks every asset as no longer needed, like when all scripts are aborted. Must be called on the main thread.
+        /// </summary>
+        internal void ReleaseAll()
+        {
+            lock (_lock)
+            {
+                for (int i = _requests.Count - 1; i >= 0; i--)
+                {
+                    StreamingRequest request = _requests[i];
+                    request._holders.Clear();
+                    RemoveRequest(i, request);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Polls the pending and loaded requests and releases the ones nobody needs anymore. Must be called on the main
+        /// thread.
+        /// </summary>
+        internal unsafe void Update()
+        {
+            lock (_lock)
+            {
+                if (_requests.Count == 0)
+                {
+                    return;
+                }
+
+                long timestamp = Stopwatch.GetTimestamp();
+
+                for (int i = _requests.Count - 1; i >= 0; i--)
+                {
+                    StreamingRequest request = _requests[i];
+
+                    if (request._holders.Count == 0 && timestamp >= request._prefetchDeadline)
+                    {
+                        RemoveRequest(i, request);
+                        continue;
+                    }
+
+                    if (request.IsFailed)
+                    {
+                        continue;
+                    }
+
+                    int assetTypeIndex = (int)request.AssetType;
+                    ulong arg = GetNativeArgument(request);
+
+                    if (request.IsLoaded)
+                    {
+                        if (*(int*)NativeFunc.InvokeInternal(s_hasLoadedHashes[assetTypeIndex], &arg, 1) != 0)
+                        {
+                            continue;
+                        }
+
+                        // Another mod or a v2 script, which do not go through the manager, unloaded the asset, so load
+                        // it again for the scripts that still hold it
+                        request.Restart(timestamp);
+                    }
+
+                    if (!request._hasBeenPolled)
+                    {
+                        request._hasBeenPolled = true;
+
+                        if (!DoesAssetExist(request.AssetType, arg))
+                        {
+                            _failedLoadCount++;
+                            request.Complete(false, timestamp);
+                            continue;
+                        }
+                    }
+
+                    // Keep requesting like the scripts of the game do, the request may be dropped when the asset is
+                    // evicted while loading
+                    NativeFunc.InvokeInternal(s_requestHashes[assetTypeIndex], &arg, 1);
+
+                    if (*(int*)NativeFunc.InvokeInternal(s_hasLoadedHashes[assetTypeIndex], &arg, 1) != 0)
+                    {
+                        long loadTicks = timestamp - request._requestTimestamp;
+                        _completedLoadCount++;
+                        _totalLoadTicks += loadTicks;
+                        if (loadTicks > _maxLoadTicks)
+                        {
+                            _maxLoadTicks = loadTicks;
+                        }
+
+                        request.Complete(true, timestamp);
+                    }
+                }
+            }
+        }
+
+        internal static Script GetExecutingScript()
+        {
+            Script script = ScriptDomain.ExecutingScript;
+            if (script == null)
+            {
+                throw new InvalidOperationException("Streaming requests can only be made from a script.");
+            }
+
+            return script;
+        }
+
+        private unsafe StreamingRequest GetOrAddRequest(StreamingAssetType assetType, int hash, string name)
+        {
+            if (assetType != StreamingAssetType.Model && name == null)
+            {
+                throw new ArgumentNullException(nameof(name));
+            }
+
+            var key = new AssetKey(assetType, hash, assetType != StreamingAssetType.Model ? name : null);
+            if (!_requestsByKey.TryGetValue(key, out StreamingRequest request))
+            {
+                request = new StreamingRequest(this, assetType, hash, name)
+                {
+                    _requestTimestamp = Stopwatch.GetTimestamp(),
+                };
+                if (assetType != StreamingAssetType.Model)
+                {
+                    request._nativeName = StringMarshal.StringToCoTaskMemUtf8(name);
+                }
+
+                _requestsByKey.Add(key, request);
+                _requests.Add(request);
+
+                // Send the first request right away instead of in the next frame, like calling the native directly
+                // does. Compute handlers cannot call script functions, so theirs is sent by the next update.
+                if (ScriptDomain.ExecutingScript != null && ScriptComputePhase.ComputingScript == null)
+                {
+                    ulong arg = GetNativeArgument(request);
+                    NativeFunc.Invoke(s_requestHashes[(int)assetType], &arg, 1);
+                }
+            }
+
+            return request;
+        }
+
+        private unsafe void RemoveRequest(int index, StreamingRequest request)
+        {
+            if (!request.IsFailed)
+            {
+                ulong arg = GetNativeArgument(request);
+                NativeFunc.InvokeInternal(s_releaseHashes[(int)request.AssetType], &arg, 1);
+            }
+
+            // Nobody holds the asset anymore, so waiting scripts are told it did not load
+            if (!request.IsCompleted)
+            {
+                request.Complete(false, 0);
+            }
+
+            if (request._nativeName != IntPtr.Zero)
+            {
+                Marshal.FreeCoTaskMem(request._nativeName);
+                request._nativeName = IntPtr.Zero;
+            }
+
+            _requestsByKey.Remove(new AssetKey(request.AssetType, request.Hash, request.AssetType != StreamingAssetType.Model ? request.Name : null));
+            _requests[index] = _requests[_requests.Count - 1];
+            _requests.RemoveAt(_requests.Count - 1);
+        }
+
+        private static ulong GetNativeArgument(StreamingRequest request)
+        {
+            return request.AssetType == StreamingAssetType.Model ? (ulong)request.Hash : (ulong)request._nativeName.ToInt64();
+        }
+
+        private static unsafe bool DoesAssetExist(StreamingAssetType assetType, ulong arg)
+        {
+            switch (assetType)
+            {
+                case StreamingAssetType.Model:
+                    return *(int*)NativeFunc.InvokeInternal(IsModelInCdImageHash, &arg, 1) != 0;
+                case StreamingAssetType.ClipDictionary:
+                    return *(int*)NativeFunc.InvokeInternal(DoesAnimDictExistHash, &arg, 1) != 0;
+                default:
+                    // The other kinds have no cheap existence check, so they stay pending until they are released
+                    return true;
+            }
+        }
+
+        private static TimeSpan StopwatchTicksToTimeSpan(long ticks)
+        {
+            return TimeSpan.FromSeconds((double)ticks / Stopwatch.Frequency);
+        }
+    }
+}
@@ -62,7 +62,10 @@ namespace GTA.Graphics
         /// </remarks>
         public void Request()
         {
-            Function.Call(Hash.REQUEST_STREAMED_TEXTURE_DICT, Name);
+            if (Streaming.Acquire(SHVDN.StreamingAssetType.TextureDictionary, 0, Name) == null)
+            {
+                Function.Call(Hash.REQUEST_STREAMED_TEXTURE_DICT, Name);
+            }
         }
         /// <summary>
         /// Attempts to load the textures of this <see cref="Txd"/> into memory for a given period of time.
@@ -76,23 +79,30 @@ namespace GTA.Graphics
         /// </remarks>
         public bool Request(int timeout)
         {
-            Request();
-
-            int startTime = Environment.TickCount;
-            int maxElapsedTime = timeout >= 0 ? timeout : int.MaxValue;
-
-            while (!IsLoaded)
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.TextureDictionary, 0, Name);
+            if (request == null)
             {
-                Script.Yield();
-                Request();
+                Function.Call(Hash.REQUEST_STREAMED_TEXTURE_DICT, Name);
+                return IsLoaded;
+            }
 
-                if (Environment.TickCount - startTime >= maxElapsedTime)
-                {
-                    return false;
-                }
+            return Streaming.Wait(request, timeout);
+        }
+        /// <summary>
+        /// Attempts to load this <see cref="Txd"/> into memory without waiting for it.
+        /// Scripts that request the same <see cref="Txd"/> share one <see cref="StreamingRequest"/>.
+        /// </summary>
+        /// <returns>The request, which can be awaited or used to register a callback.</returns>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public StreamingRequest RequestAsync()
+        {
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.TextureDictionary, 0, Name);
+            if (request == null)
+            {
+                throw new InvalidOperationException("Streaming requests can only be made from a script.");
             }
 
-            return true;
+            return new StreamingRequest(request);
         }
 
         /// <summary>
@@ -106,7 +116,10 @@ namespace GTA.Graphics
         /// </remarks>
         public void MarkAsNoLongerNeeded()
         {
-            Function.Call(Hash.SET_STREAMED_TEXTURE_DICT_AS_NO_LONGER_NEEDED, Name);
+            if (!Streaming.Release(SHVDN.StreamingAssetType.TextureDictionary, 0, Name))
+            {
+                Function.Call(Hash.SET_STREAMED_TEXTURE_DICT_AS_NO_LONGER_NEEDED, Name);
+            }
         }
 
         /// <summary>
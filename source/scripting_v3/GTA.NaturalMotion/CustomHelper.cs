@@ -121,6 +121,15 @@ namespace GTA.NaturalMotion
             _message.SetArgument(argName, value);
         }
 
+        /// <summary>
+        /// Creates an immutable <see cref="MessageTemplate"/> from the arguments set on this helper, which can be sent to
+        /// many peds without building the message again.
+        /// </summary>
+        public MessageTemplate Compile()
+        {
+            return _message.Compile();
+        }
+
         /// <summary>
         /// Resets all arguments to their default values.
         /// </summary>
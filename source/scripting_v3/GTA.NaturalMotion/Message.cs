@@ -4,7 +4,6 @@
 //
 
 using GTA.Math;
-using GTA.Native;
 using System;
 using System.Collections.Generic;
 using System.ComponentModel;
@@ -17,10 +16,9 @@ namespace GTA.NaturalMotion
     public class Message
     {
         #region Fields
-        private string _message;
-        private Dictionary<string, (int value, Type type)> _boolIntFloatArguments;
-        private Dictionary<string, object> _stringVector3ArrayArguments;
-        private static readonly Dictionary<string, (int value, Type type)> s_stopArgument = new() { { "start", (0, typeof(bool)) } };
+        private readonly string _message;
+        private readonly IntPtr _messageName;
+        private readonly MessageArgumentList _arguments;
         #endregion
 
         /// <summary>
@@ -30,8 +28,17 @@ namespace GTA.NaturalMotion
         public Message(string message)
         {
             _message = message;
-            _boolIntFloatArguments = new Dictionary<string, (int value, Type type)>();
-            _stringVector3ArrayArguments = new Dictionary<string, object>();
+            _messageName = SHVDN.NativeMemory.GetPinnedNmString(message);
+            _arguments = new MessageArgumentList();
+        }
+
+        /// <summary>
+        /// Creates an immutable <see cref="MessageTemplate"/> from the current arguments of this <see cref="Message"/>.
+        /// Later changes to this <see cref="Message"/> do not affect the template.
+        /// </summary>
+        public MessageTemplate Compile()
+        {
+            return new MessageTemplate(_message, _messageName, _arguments.Clone());
         }
 
         /// <summary>
@@ -40,12 +47,7 @@ namespace GTA.NaturalMotion
         /// <param name="target">The <see cref="Ped"/> to stop the behavior on.</param>
         public void Abort(Ped target)
         {
-            if (target == null || !target.Exists())
-            {
-                return;
-            }
-
-            SHVDN.NativeMemory.SendNmMessage(target.Handle, _message, s_stopArgument, null);
+            MessageTemplate.StopArguments.SendTo(_messageName, target, false, false, -1);
         }
 
         /// <summary>
@@ -58,27 +60,7 @@ namespace GTA.NaturalMotion
         /// </remarks>
         public void SendTo(Ped target)
         {
-            if (target == null || !target.Exists())
-            {
-                return;
-            }
-
-            if (!target.IsRagdoll)
-            {
-                if (!target.CanRagdoll)
-                {
-                    target.CanRagdoll = true;
-                }
-            }
-
-            if (!SHVDN.NativeMemory.IsTaskNmScriptControlOrEventSwitch2NmActive(target.MemoryAddress))
-            {
-                // Does not call when a CTaskNMControl task is active or the CEvent (which usually causes some task) related to CTaskNMControl occured for calling SET_PED_TO_RAGDOLL just like in legacy scripts.
-                // Otherwise, the ragdoll duration will be overridden.
-                Function.Call(Hash.SET_PED_TO_RAGDOLL, target.Handle, 10000, -1, 1, 1, 1, 0);
-            }
-
-            SHVDN.NativeMemory.SendNmMessage(target.Handle, _message, _boolIntFloatArguments, _stringVector3ArrayArguments);
+            _arguments.SendTo(_messageName, target, true, false, -1);
         }
         /// <summary>
         ///	Starts this behavior on the given <see cref="Ped"/> for a specified duration.
@@ -88,19 +70,25 @@ namespace GTA.NaturalMotion
         /// <param name="duration">How long to apply the behavior for (-1 for looped).</param>
         public void SendTo(Ped target, int duration)
         {
-            if (target == null || !target.Exists())
-            {
-                return;
-            }
-
-            if (!target.CanRagdoll)
-            {
-                target.CanRagdoll = true;
-            }
-
-            // Always call to specify the new duration
-            Function.Call(Hash.SET_PED_TO_RAGDOLL, target.Handle, 10000, duration, 1, 1, 1, 0);
-            SendTo(target);
+            _arguments.SendTo(_messageName, target, true, true, duration);
+        }
+        /// <summary>
+        /// Sends the message for this behavior to all the given peds at once.
+        /// Starts a <c>CTaskNMControl</c> task on each <see cref="Ped"/> that has no such task and loops it until manually aborted.
+        /// </summary>
+        /// <param name="targets">The peds to send the <see cref="Message"/> to.</param>
+        public void SendTo(IReadOnlyList<Ped> targets)
+        {
+            _arguments.SendTo(_messageName, targets, true, false, -1);
+        }
+        /// <summary>
+        ///	Starts this behavior on all the given peds at once for a specified duration.
+        /// </summary>
+        /// <param name="targets">The peds to send the <see cref="Message"/> to.</param>
+        /// <param name="duration">How long to apply the behavior for (-1 for looped).</param>
+        public void SendTo(IReadOnlyList<Ped> targets, int duration)
+        {
+            _arguments.SendTo(_messageName, targets, true, true, duration);
         }
 
         /// <summary>
@@ -110,10 +98,7 @@ namespace GTA.NaturalMotion
         /// <param name="value">The value to set the argument to.</param>
         public void SetArgument(string argName, bool value)
         {
-            CreateBoolIntFloatArgDictIfNotCreated();
-
-            int valueConverted = value ? 1 : 0;
-            _boolIntFloatArguments[argName] = (valueConverted, typeof(bool));
+            _arguments.Set(argName, value);
         }
         /// <summary>
         /// Sets an argument to a <see cref="int"/> value.
@@ -122,9 +107,7 @@ namespace GTA.NaturalMotion
         /// <param name="value">The value to set the argument to.</param>
         public void SetArgument(string argName, int value)
         {
-            CreateBoolIntFloatArgDictIfNotCreated();
-
-            _boolIntFloatArguments[argName] = (value, typeof(int));
+            _arguments.Set(argName, value);
         }
         /// <summary>
         /// Sets an argument to a <see cref="float"/> value.
@@ -133,13 +116,7 @@ namespace GTA.NaturalMotion
         /// <param name="value">The value to set the argument to.</param>
         public void SetArgument(string argName, float value)
         {
-            CreateBoolIntFloatArgDictIfNotCreated();
-
-            unsafe
-            {
-                int valueConverted = *(int*)&value;
-                _boolIntFloatArguments[argName] = (valueConverted, typeof(float));
-            }
+            _arguments.Set(argName, value);
         }
         /// <summary>
         /// Sets an argument to a <see cref="string"/> value.
@@ -148,9 +125,7 @@ namespace GTA.NaturalMotion
         /// <param name="value">The value to set the argument to.</param>
         public void SetArgument(string argName, string value)
         {
-            CreateStringVector3ArrayArgDictIfNotCreated();
-
-            _stringVector3ArrayArguments[argName] = value;
+            _arguments.Set(argName, value);
         }
         /// <summary>
         /// Sets an argument to a <see cref="Vector3"/> value.
@@ -159,9 +134,7 @@ namespace GTA.NaturalMotion
         /// <param name="value">The value to set the argument to.</param>
         public void SetArgument(string argName, Vector3 value)
         {
-            CreateStringVector3ArrayArgDictIfNotCreated();
-
-            _stringVector3ArrayArguments[argName] = value.ToArray();
+            _arguments.Set(argName, value);
         }
 
         /// <summary>
@@ -170,17 +143,7 @@ namespace GTA.NaturalMotion
         /// <param name="argName">The argument name.</param>
         public bool RemoveArgument(string argName)
         {
-            if (_boolIntFloatArguments != null)
-            {
-                return _boolIntFloatArguments.Remove(argName);
-            }
-
-            if (_stringVector3ArrayArguments == null)
-            {
-                return false;
-            }
-
-            return _stringVector3ArrayArguments.Remove(argName);
+            return _arguments.Remove(argName);
         }
 
         /// <summary>
@@ -188,8 +151,7 @@ namespace GTA.NaturalMotion
         /// </summary>
         public void ResetArguments()
         {
-            _boolIntFloatArguments?.Clear();
-            _stringVector3ArrayArguments?.Clear();
+            _arguments.Clear();
         }
 
         /// <summary>
@@ -199,7 +161,7 @@ namespace GTA.NaturalMotion
         [EditorBrowsable(EditorBrowsableState.Never)]
         public void CreateBoolIntFloatArgDictIfNotCreated()
         {
-            _boolIntFloatArguments ??= new Dictionary<string, (int value, Type type)>();
+            // Arguments are no longer stored in dictionaries, this is only kept for compatibility
         }
 
         /// <summary>
@@ -209,7 +171,7 @@ namespace GTA.NaturalMotion
         [EditorBrowsable(EditorBrowsableState.Never)]
         public void CreateStringVector3ArrayArgDictIfNotCreated()
         {
-            _stringVector3ArrayArguments ??= new Dictionary<string, object>();
+            // Arguments are no longer stored in dictionaries, this is only kept for compatibility
         }
 
         /// <summary>
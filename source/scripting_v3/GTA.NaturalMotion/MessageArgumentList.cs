@@ -0,0 +1,183 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using GTA.Math;
+using System;
+using System.Collections.Generic;
+using NmParameter = SHVDN.NativeMemory.NmParameter;
+using NmParameterType = SHVDN.NativeMemory.NmParameterType;
+
+namespace GTA.NaturalMotion
+{
+    /// <summary>
+    /// Stores the arguments of a NaturalMotion message in a flat array whose names are already pinned, so they can
+    /// be passed to the game as they are. String values are only pinned while the message is sent.
+    /// </summary>
+    /// <remarks>
+    /// Arguments are looked up with a linear search, which is cheap for the few dozen arguments a message has at most
+    /// and keeps them in the order they were set in.
+    /// </remarks>
+    internal sealed class MessageArgumentList
+    {
+        #region Fields
+        private string[] _names;
+        private NmParameter[] _parameters;
+        private int _count;
+
+        [ThreadStatic]
+        private static int[] s_targetHandles;
+        #endregion
+
+        internal MessageArgumentList() : this(8)
+        {
+        }
+        private MessageArgumentList(int capacity)
+        {
+            _names = new string[capacity];
+            _parameters = new NmParameter[capacity];
+        }
+
+        internal int Count => _count;
+
+        internal MessageArgumentList Clone()
+        {
+            var clone = new MessageArgumentList(System.Math.Max(_count, 1));
+            Array.Copy(_names, clone._names, _count);
+            Array.Copy(_parameters, clone._parameters, _count);
+            clone._count = _count;
+            return clone;
+        }
+
+        internal void Set(string argName, bool value)
+        {
+            ref NmParameter parameter = ref GetOrAdd(argName);
+            parameter.Type = NmParameterType.Bool;
+            parameter.IntValue = value ? 1 : 0;
+        }
+        internal void Set(string argName, int value)
+        {
+            ref NmParameter parameter = ref GetOrAdd(argName);
+            parameter.Type = NmParameterType.Int;
+            parameter.IntValue = value;
+        }
+        internal void Set(string argName, float value)
+        {
+            ref NmParameter parameter = ref GetOrAdd(argName);
+            parameter.Type = NmParameterType.Float;
+            parameter.X = value;
+        }
+        internal void Set(string argName, string value)
+        {
+            ref NmParameter parameter = ref GetOrAdd(argName);
+            parameter.Type = NmParameterType.String;
+            parameter.StringValue = value;
+        }
+        internal void Set(string argName, Vector3 value)
+        {
+            ref NmParameter parameter = ref GetOrAdd(argName);
+            parameter.Type = NmParameterType.Vector3;
+            parameter.X = value.X;
+            parameter.Y = value.Y;
+            parameter.Z = value.Z;
+        }
+
+        internal bool Remove(string argName)
+        {
+            int index = IndexOf(argName);
+            if (index < 0)
+            {
+                return false;
+            }
+
+            _count--;
+            Array.Copy(_names, index + 1, _names, index, _count - index);
+            Array.Copy(_parameters, index + 1, _parameters, index, _count - index);
+            _names[_count] = null;
+            _parameters[_count] = default;
+            return true;
+        }
+
+        internal void Clear()
+        {
+            Array.Clear(_names, 0, _count);
+            Array.Clear(_parameters, 0, _count);
+            _count = 0;
+        }
+
+        internal void SendTo(IntPtr messageName, Ped target, bool prepareRagdoll, bool restartRagdoll, int ragdollDuration)
+        {
+            if (target == null)
+            {
+                return;
+            }
+
+            int[] targetHandles = GetTargetHandleBuffer(1);
+            targetHandles[0] = target.Handle;
+            SHVDN.NativeMemory.SendNmMessage(targetHandles, 1, messageName, _parameters, _count, prepareRagdoll, restartRagdoll, ragdollDuration);
+        }
+        internal void SendTo(IntPtr messageName, IReadOnlyList<Ped> targets, bool prepareRagdoll, bool restartRagdoll, int ragdollDuration)
+        {
+            if (targets == null)
+            {
+                throw new ArgumentNullException(nameof(targets));
+            }
+
+            int[] targetHandles = GetTargetHandleBuffer(targets.Count);
+            int targetCount = 0;
+            for (int i = 0; i < targets.Count; i++)
+            {
+                Ped target = targets[i];
+                if (target != null)
+                {
+                    targetHandles[targetCount++] = target.Handle;
+                }
+            }
+
+            SHVDN.NativeMemory.SendNmMessage(targetHandles, targetCount, messageName, _parameters, _count, prepareRagdoll, restartRagdoll, ragdollDuration);
+        }
+
+        private ref NmParameter GetOrAdd(string argName)
+        {
+            int index = IndexOf(argName);
+            if (index >= 0)
+            {
+                return ref _parameters[index];
+            }
+
+            if (_count == _names.Length)
+            {
+                Array.Resize(ref _names, _names.Length * 2);
+                Array.Resize(ref _parameters, _parameters.Length * 2);
+            }
+
+            _names[_count] = argName;
+            _parameters[_count].Name = SHVDN.NativeMemory.GetPinnedNmString(argName);
+            return ref _parameters[_count++];
+        }
+
+        private int IndexOf(string argName)
+        {
+            for (int i = 0; i < _count; i++)
+            {
+                if (string.Equals(_names[i], argName, StringComparison.Ordinal))
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        private static int[] GetTargetHandleBuffer(int count)
+        {
+            if (s_targetHandles == null || s_targetHandles.Length < count)
+            {
+                s_targetHandles = new int[System.Math.Max(count, 16)];
+            }
+
+            return s_targetHandles;
+        }
+    }
+}
@@ -0,0 +1,187 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using GTA.Math;
+using System;
+using System.Collections.Generic;
+
+namespace GTA.NaturalMotion
+{
+    /// <summary>
+    /// An immutable, pre-compiled NaturalMotion Euphoria message that can be sent to any number of peds.
+    /// </summary>
+    /// <remarks>
+    /// The argument names of a template are converted for the game once when they are added, and its values are stored
+    /// in a flat array that is passed to the game as it is, so sending a template does not allocate.
+    /// The <c>WithArgument</c> methods return a copy of the template and leave the original untouched, so a template
+    /// can be shared between scripts and peds. Use <see cref="Message.Compile"/> to create one from a <see cref="Message"/>.
+    /// </remarks>
+    public sealed class MessageTemplate
+    {
+        #region Fields
+        private readonly string _message;
+        private readonly IntPtr _messageName;
+        private readonly MessageArgumentList _arguments;
+
+        internal static readonly MessageArgumentList StopArguments = CreateStopArguments();
+        #endregion
+
+        /// <summary>
+        /// Creates a template of a NaturalMotion Euphoria message without any arguments.
+        /// </summary>
+        /// <param name="message">The name of the message.</param>
+        public MessageTemplate(string message) : this(message, SHVDN.NativeMemory.GetPinnedNmString(message), new MessageArgumentList())
+        {
+        }
+        internal MessageTemplate(string message, IntPtr messageName, MessageArgumentList arguments)
+        {
+            _message = message;
+            _messageName = messageName;
+            _arguments = arguments;
+        }
+
+        /// <summary>
+        /// Gets the number of arguments set in this <see cref="MessageTemplate"/>.
+        /// </summary>
+        public int ArgumentCount => _arguments.Count;
+
+        /// <summary>
+        /// Returns a copy of this <see cref="MessageTemplate"/> with an argument set to a <see cref="bool"/> value.
+        /// </summary>
+        /// <param name="argName">The argument name.</param>
+        /// <param name="value">The value to set the argument to.</param>
+        public MessageTemplate WithArgument(string argName, bool value)
+        {
+            MessageArgumentList arguments = _arguments.Clone();
+            arguments.Set(argName, value);
+            return new MessageTemplate(_message, _messageName, arguments);
+        }
+        /// <summary>
+        /// Returns a copy of this <see cref="MessageTemplate"/> with an argument set to a <see cref="int"/> value.
+        /// </summary>
+        /// <param name="argName">The argument name.</param>
+        /// <param name="value">The value to set the argument to.</param>
+        public MessageTemplate WithArgument(string argName, int value)
+        {
+            MessageArgumentList arguments = _arguments.Clone();
+            arguments.Set(argName, value);
+            return new MessageTemplate(_message, _messageName, arguments);
+        }
+        /// <summary>
+        /// Returns a copy of this <see cref="MessageTemplate"/> with an argument set to a <see cref="float"/> value.
+        /// </summary>
+        /// <param name="argName">The argument name.</param>
+        /// <param name="value">The value to set the argument to.</param>
+        public MessageTemplate WithArgument(string argName, float value)
+        {
+            MessageArgumentList arguments = _arguments.Clone();
+            arguments.Set(argName, value);
+            return new MessageTemplate(_message, _messageName, arguments);
+        }
+        /// <summary>
+        /// Returns a copy of this <see cref="MessageTemplate"/> with an argument set to a <see cref="string"/> value.
+        /// </summary>
+        /// <param name="argName">The argument name.</param>
+        /// <param name="value">The value to set the argument to.</param>
+        public MessageTemplate WithArgument(string argName, string value)
+        {
+            MessageArgumentList arguments = _arguments.Clone();
+            arguments.Set(argName, value);
+            return new MessageTemplate(_message, _messageName, arguments);
+        }
+        /// <summary>
+        /// Returns a copy of this <see cref="MessageTemplate"/> with an argument set to a <see cref="Vector3"/> value.
+        /// </summary>
+        /// <param name="argName">The argument name.</param>
+        /// <param name="value">The value to set the argument to.</param>
+        public MessageTemplate WithArgument(string argName, Vector3 value)
+        {
+            MessageArgumentList arguments = _arguments.Clone();
+            arguments.Set(argName, value);
+            return new MessageTemplate(_message, _messageName, arguments);
+        }
+
+        /// <summary>
+        /// Returns a copy of this <see cref="MessageTemplate"/> without an argument.
+        /// Returns this instance if the argument is not set.
+        /// </summary>
+        /// <param name="argName">The argument name.</param>
+        public MessageTemplate WithoutArgument(string argName)
+        {
+            MessageArgumentList arguments = _arguments.Clone();
+            return arguments.Remove(argName) ? new MessageTemplate(_message, _messageName, arguments) : this;
+        }
+
+        /// <summary>
+        /// Stops this behavior on the given <see cref="Ped"/>.
+        /// </summary>
+        /// <param name="target">The <see cref="Ped"/> to stop the behavior on.</param>
+        public void Abort(Ped target)
+        {
+            StopArguments.SendTo(_messageName, target, false, false, -1);
+        }
+        /// <summary>
+        /// Stops this behavior on all the given peds at once.
+        /// </summary>
+        /// <param name="targets">The peds to stop the behavior on.</param>
+        public void Abort(IReadOnlyList<Ped> targets)
+        {
+            StopArguments.SendTo(_messageName, targets, false, false, -1);
+        }
+
+        /// <summary>
+        /// Sends this message to the given <see cref="Ped"/>. Will not start it unless the <c>"start"</c> argument is set.
+        /// Starts a <c>CTaskNMControl</c> task if the <see cref="Ped"/> has no such task and loops it until manually aborted.
+        /// </summary>
+        /// <param name="target">The <see cref="Ped"/> to send the message to.</param>
+        public void SendTo(Ped target)
+        {
+            _arguments.SendTo(_messageName, target, true, false, -1);
+        }
+        /// <summary>
+        ///	Starts this behavior on the given <see cref="Ped"/> for a specified duration.
+        ///	Always starts a new ragdoll task, making it impossible to stack multiple behaviors on the <see cref="Ped"/>.
+        /// </summary>
+        /// <param name="target">The <see cref="Ped"/> to send the message to.</param>
+        /// <param name="duration">How long to apply the behavior for (-1 for looped).</param>
+        public void SendTo(Ped target, int duration)
+        {
+            _arguments.SendTo(_messageName, target, true, true, duration);
+        }
+        /// <summary>
+        /// Sends this message to all the given peds with a single switch to the game thread.
+        /// Starts a <c>CTaskNMControl</c> task on each <see cref="Ped"/> that has no such task and loops it until manually aborted.
+        /// </summary>
+        /// <param name="targets">The peds to send the message to. <see langword="null" /> elements are skipped.</param>
+        public void SendTo(IReadOnlyList<Ped> targets)
+        {
+            _arguments.SendTo(_messageName, targets, true, false, -1);
+        }
+        /// <summary>
+        ///	Starts this behavior on all the given peds with a single switch to the game thread for a specified duration.
+        /// </summary>
+        /// <param name="targets">The peds to send the message to. <see langword="null" /> elements are skipped.</param>
+        /// <param name="duration">How long to apply the behavior for (-1 for looped).</param>
+        public void SendTo(IReadOnlyList<Ped> targets, int duration)
+        {
+            _arguments.SendTo(_messageName, targets, true, true, duration);
+        }
+
+        /// <summary>
+        /// Returns the internal message name.
+        /// </summary>
+        public override string ToString()
+        {
+            return _message;
+        }
+
+        private static MessageArgumentList CreateStopArguments()
+        {
+            var arguments = new MessageArgumentList();
+            arguments.Set("start", false);
+            return arguments;
+        }
+    }
+}
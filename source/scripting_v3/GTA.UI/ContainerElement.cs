@@ -142,7 +142,11 @@ namespace GTA.UI
                 return;
             }
 
-            InternalDraw(offset, Screen.Width, Screen.Height);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseScreenOrigin();
+            InternalDraw(recorder, offset, Screen.Width, Screen.Height);
+            recorder.EndElement();
 
             offset += new SizeF(Position);
 
@@ -175,7 +179,11 @@ namespace GTA.UI
                 return;
             }
 
-            InternalDraw(offset, Screen.ScaledWidth, Screen.Height);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseScreenOrigin();
+            InternalDraw(recorder, offset, Screen.ScaledWidth, Screen.Height);
+            recorder.EndElement();
 
             offset += new SizeF(Position);
 
@@ -205,9 +213,11 @@ namespace GTA.UI
         /// <param name="offset">The offset to shift the draw position of this <see cref="ContainerElement"/> using a 1280*720 pixel base.</param>
         public virtual void WorldDraw(Vector3 position, SizeF offset)
         {
-            Function.Call(Hash.SET_DRAW_ORIGIN, position.X, position.Y, position.Z, 0);
-            InternalDraw(offset, Screen.Width, Screen.Height);
-            Function.Call(Hash.CLEAR_DRAW_ORIGIN);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseDrawOrigin(position);
+            InternalDraw(recorder, offset, Screen.Width, Screen.Height);
+            recorder.EndElement();
         }
         /// <summary>
         /// Draws this <see cref="ContainerElement"/> this frame at the specified <see cref="Vector3"/> position and offset using the width returned in <see cref="Screen.ScaledWidth"/>.
@@ -224,12 +234,14 @@ namespace GTA.UI
         /// <param name="offset">The offset to shift the draw position of this <see cref="ContainerElement"/> using a <see cref="Screen.ScaledWidth"/>*720 pixel base.</param>
         public virtual void WorldScaledDraw(Vector3 position, SizeF offset)
         {
-            Function.Call(Hash.SET_DRAW_ORIGIN, position.X, position.Y, position.Z, 0);
-            InternalDraw(offset, Screen.ScaledWidth, Screen.Height);
-            Function.Call(Hash.CLEAR_DRAW_ORIGIN);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseDrawOrigin(position);
+            InternalDraw(recorder, offset, Screen.ScaledWidth, Screen.Height);
+            recorder.EndElement();
         }
 
-        void InternalDraw(SizeF offset, float screenWidth, float screenHeight)
+        void InternalDraw(DrawList.Recorder recorder, SizeF offset, float screenWidth, float screenHeight)
         {
             float w = Size.Width / screenWidth;
             float h = Size.Height / screenHeight;
@@ -242,7 +254,16 @@ namespace GTA.UI
                 y += h * 0.5f;
             }
 
-            Function.Call(Hash.DRAW_RECT, x, y, w, h, Color.R, Color.G, Color.B, Color.A);
+            SHVDN.NativeCallBatch batch = recorder.Batch;
+            batch.BeginCall((ulong)Hash.DRAW_RECT);
+            batch.PushArgument(x);
+            batch.PushArgument(y);
+            batch.PushArgument(w);
+            batch.PushArgument(h);
+            batch.PushArgument((int)Color.R);
+            batch.PushArgument((int)Color.G);
+            batch.PushArgument((int)Color.B);
+            batch.PushArgument((int)Color.A);
         }
     }
 }
@@ -0,0 +1,238 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using GTA.Math;
+using GTA.Native;
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+
+namespace GTA.UI
+{
+    /// <summary>
+    /// Controls how the draw calls of <see cref="TextElement"/>, <see cref="Sprite"/> and <see cref="ContainerElement"/>
+    /// are submitted to the game for the executing script.
+    /// </summary>
+    /// <remarks>
+    /// Every draw of these elements is encoded into a list of native calls that is submitted in one batch, so drawing
+    /// an element only costs one switch into the game thread context. By default the list is submitted as soon as
+    /// a draw method returns. When <see cref="IsRetained"/> is set, the list is kept until the script yields
+    /// (when the tick ends or <see cref="Script.Wait(int)"/> is called), so all the elements drawn in one tick are
+    /// submitted in a single batch and redundant draw origin changes between them are skipped.
+    /// </remarks>
+    public static class DrawList
+    {
+        private static readonly ConditionalWeakTable<SHVDN.Script, Recorder> s_recorders = new();
+
+        [ThreadStatic]
+        private static SHVDN.Script s_lastScript;
+        [ThreadStatic]
+        private static Recorder s_lastRecorder;
+        [ThreadStatic]
+        private static Recorder s_detachedRecorder;
+
+        /// <summary>
+        /// Gets or sets whether the draw calls of the executing script are retained until the script yields instead
+        /// of being submitted when each draw method returns.
+        /// </summary>
+        /// <remarks>
+        /// Retained draw calls are submitted after any native function the script calls directly in the same tick,
+        /// so do not enable this if your script relies on draw order between elements and direct draw natives such as
+        /// <c>DRAW_RECT</c> or <c>SET_SCRIPT_GFX_DRAW_ORDER</c>.
+        /// </remarks>
+        public static bool IsRetained
+        {
+            get => Current.IsRetained;
+            set => Current.IsRetained = value;
+        }
+
+        /// <summary>
+        /// Gets the number of native calls currently waiting in the draw list of the executing script.
+        /// </summary>
+        public static int PendingCallCount => Current.PendingCallCount;
+
+        /// <summary>
+        /// Submits all the pending draw calls of the executing script now.
+        /// </summary>
+        public static void Flush()
+        {
+            Current.Flush();
+        }
+
+        internal static Recorder Current
+        {
+            get
+            {
+                SHVDN.Script script = SHVDN.ScriptDomain.ExecutingScript;
+                if (script == null)
+                {
+                    // Not in a script tick (e.g. the console), so nothing would submit the retained calls later
+                    return s_detachedRecorder ??= new Recorder(null);
+                }
+
+                if (ReferenceEquals(script, s_lastScript))
+                {
+                    return s_lastRecorder;
+                }
+
+                Recorder recorder = s_recorders.GetValue(script, s => new Recorder(s));
+                s_lastScript = script;
+                s_lastRecorder = recorder;
+                return recorder;
+            }
+        }
+
+        internal sealed class Recorder
+        {
+            private readonly SHVDN.NativeCallBatch _batch = new();
+            private readonly List<TextElement.PinnedText> _queuedTexts = new();
+            // Only caches the loaded state within a tick, since texture dictionaries can be evicted between ticks
+            private readonly Dictionary<int, bool> _loadedTextureDicts = new();
+            private readonly bool _isAttachedToScript;
+            private bool _isRetained;
+            private int _elementDepth;
+            private bool _hasDrawOrigin;
+            private Vector3 _drawOrigin;
+
+            internal Recorder(SHVDN.Script script)
+            {
+                if (script == null)
+                {
+                    return;
+                }
+
+                _isAttachedToScript = true;
+                script.Yielding += OnScriptYielding;
+            }
+
+            internal bool IsRetained
+            {
+                get => _isRetained;
+                set
+                {
+                    if (_isRetained == value)
+                    {
+                        return;
+                    }
+
+                    // Retaining without a script to yield would mean never submitting anything
+                    _isRetained = value && _isAttachedToScript;
+                    if (!_isRetained && _elementDepth == 0)
+                    {
+                        Flush();
+                    }
+                }
+            }
+
+            internal int PendingCallCount => _batch.Count;
+
+            internal SHVDN.NativeCallBatch Batch => _batch;
+
+            internal void BeginElement()
+            {
+                _elementDepth++;
+            }
+            internal void EndElement()
+            {
+                if (--_elementDepth == 0 && !_isRetained)
+                {
+                    Flush();
+                }
+            }
+
+            /// <summary>
+            /// Makes the following calls draw relative to the screen. Only resets the draw origin if this recorder
+            /// set one, so an origin set by the script itself is left untouched.
+            /// </summary>
+            internal void UseScreenOrigin()
+            {
+                if (!_hasDrawOrigin)
+                {
+                    return;
+                }
+
+                _batch.BeginCall((ulong)Hash.CLEAR_DRAW_ORIGIN);
+                _hasDrawOrigin = false;
+            }
+            /// <summary>
+            /// Makes the following calls draw relative to <paramref name="position"/>.
+            /// </summary>
+            internal void UseDrawOrigin(Vector3 position)
+            {
+                if (_hasDrawOrigin && _drawOrigin == position)
+                {
+                    return;
+                }
+
+                _batch.BeginCall((ulong)Hash.SET_DRAW_ORIGIN);
+                _batch.PushArgument(position.X);
+                _batch.PushArgument(position.Y);
+                _batch.PushArgument(position.Z);
+                _batch.PushArgument(0);
+                _hasDrawOrigin = true;
+                _drawOrigin = position;
+            }
+
+            internal void KeepAlive(TextElement.PinnedText text)
+            {
+                text.AddQueueReference();
+                _queuedTexts.Add(text);
+            }
+
+            internal bool IsTextureDictLoaded(int hashedDictName, IntPtr pinnedDict)
+            {
+                if (_isAttachedToScript && _loadedTextureDicts.TryGetValue(hashedDictName, out bool loaded))
+                {
+                    return loaded;
+                }
+
+                loaded = Function.Call<bool>(Hash.HAS_STREAMED_TEXTURE_DICT_LOADED, pinnedDict);
+                if (_isAttachedToScript)
+                {
+                    _loadedTextureDicts[hashedDictName] = loaded;
+                }
+
+                return loaded;
+            }
+
+            internal void Flush()
+            {
+                if (_hasDrawOrigin)
+                {
+                    _batch.BeginCall((ulong)Hash.CLEAR_DRAW_ORIGIN);
+                    _hasDrawOrigin = false;
+                }
+
+                if (_batch.Count != 0)
+                {
+                    try
+                    {
+                        unsafe
+                        {
+                            SHVDN.NativeFunc.InvokeBatch(_batch);
+                        }
+                    }
+                    finally
+                    {
+                        _batch.Clear();
+                    }
+                }
+
+                foreach (TextElement.PinnedText text in _queuedTexts)
+                {
+                    text.RemoveQueueReference();
+                }
+                _queuedTexts.Clear();
+            }
+
+            private void OnScriptYielding(object sender, EventArgs e)
+            {
+                _elementDepth = 0;
+                Flush();
+                _loadedTextureDicts.Clear();
+            }
+        }
+    }
+}
@@ -8,8 +8,6 @@ using GTA.Native;
 using System;
 using System.Collections.Generic;
 using System.Drawing;
-using System.Runtime.InteropServices;
-using System.Text;
 
 namespace GTA.UI
 {
@@ -66,12 +64,9 @@ namespace GTA.UI
         /// <param name="centered">Position the <see cref="Sprite"/> based on its center instead of top left corner, see also <seealso cref="Centered"/>.</param>
         public Sprite(string textureDict, string textureName, SizeF size, PointF position, Color color, float rotation, bool centered)
         {
-            byte[] data = Encoding.UTF8.GetBytes(textureDict + "\0");
-            _pinnedDict = Marshal.AllocCoTaskMem(data.Length);
-            Marshal.Copy(data, 0, _pinnedDict, data.Length);
-            data = Encoding.UTF8.GetBytes(textureName + "\0");
-            _pinnedName = Marshal.AllocCoTaskMem(data.Length);
-            Marshal.Copy(data, 0, _pinnedName, data.Length);
+            _pinnedNames = TextElement.PinnedText.FromStrings(textureDict, textureName);
+            _pinnedDict = _pinnedNames.Chunks[0];
+            _pinnedName = _pinnedNames.Chunks[1];
 
             _textureDict = textureDict;
             _textureName = textureName;
@@ -86,6 +81,7 @@ namespace GTA.UI
             Function.Call(Hash.REQUEST_STREAMED_TEXTURE_DICT, _pinnedDict);
 
             int hashedDictName = (int)StringHash.AtStringHashUtf8(textureDict);
+            _hashedDictName = hashedDictName;
             if (s_activeTextures.ContainsKey(hashedDictName))
             {
                 s_activeTextures[hashedDictName] += 1;
@@ -98,11 +94,13 @@ namespace GTA.UI
 
         #region Fields
         private readonly string _textureDict, _textureName;
+        private readonly int _hashedDictName;
         /// <summary>
         /// The dictionary to count how many instances use the same texture dictionary.
         /// Using hashes for texture dictionary names should do the job since the game uses hashes for those names in the fwTxdStore.
         /// </summary>
         private static readonly Dictionary<int, int> s_activeTextures = new();
+        private readonly TextElement.PinnedText _pinnedNames;
         private IntPtr _pinnedDict, _pinnedName;
         private bool _disposed;
         private RectangleF _textureCoordinates;
@@ -120,7 +118,7 @@ namespace GTA.UI
                 return;
             }
 
-            int hashedDictName = (int)StringHash.AtStringHashUtf8(_textureDict);
+            int hashedDictName = _hashedDictName;
             if (s_activeTextures.TryGetValue(hashedDictName, out int currentCount))
             {
                 if (currentCount == 1)
@@ -139,8 +137,8 @@ namespace GTA.UI
                 Function.Call(Hash.SET_STREAMED_TEXTURE_DICT_AS_NO_LONGER_NEEDED, _pinnedDict);
             }
 
-            Marshal.FreeCoTaskMem(_pinnedDict);
-            Marshal.FreeCoTaskMem(_pinnedName);
+            // Draws retained by any script keep the names alive until they are submitted
+            _pinnedNames.Release();
             _pinnedDict = IntPtr.Zero;
             _pinnedName = IntPtr.Zero;
 
@@ -251,7 +249,11 @@ namespace GTA.UI
         /// <param name="offset">The offset.</param>
         public virtual void Draw(SizeF offset)
         {
-            InternalDraw(offset, Screen.Width, Screen.Height);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseScreenOrigin();
+            InternalDraw(recorder, offset, Screen.Width, Screen.Height);
+            recorder.EndElement();
         }
 
         /// <summary>
@@ -267,7 +269,11 @@ namespace GTA.UI
         /// <param name="offset">The offset.</param>
         public virtual void ScaledDraw(SizeF offset)
         {
-            InternalDraw(offset, Screen.ScaledWidth, Screen.Height);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseScreenOrigin();
+            InternalDraw(recorder, offset, Screen.ScaledWidth, Screen.Height);
+            recorder.EndElement();
         }
 
         /// <summary>
@@ -285,9 +291,11 @@ namespace GTA.UI
         /// <param name="offset">The offset to shift the draw position of this <see cref="Sprite"/> using a 1280*720 pixel base.</param>
         public virtual void WorldDraw(Vector3 position, SizeF offset)
         {
-            Function.Call(Hash.SET_DRAW_ORIGIN, position.X, position.Y, position.Z, 0);
-            InternalDraw(offset, Screen.Width, Screen.Height);
-            Function.Call(Hash.CLEAR_DRAW_ORIGIN);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseDrawOrigin(position);
+            InternalDraw(recorder, offset, Screen.Width, Screen.Height);
+            recorder.EndElement();
         }
         /// <summary>
         /// Draws this <see cref="Sprite"/> this frame at the specified <see cref="Vector3"/> position and offset using the width returned in <see cref="Screen.ScaledWidth"/>.
@@ -304,14 +312,16 @@ namespace GTA.UI
         /// <param name="offset">The offset to shift the draw position of this <see cref="Sprite"/> using a <see cref="Screen.ScaledWidth"/>*720 pixel base.</param>
         public virtual void WorldScaledDraw(Vector3 position, SizeF offset)
         {
-            Function.Call(Hash.SET_DRAW_ORIGIN, position.X, position.Y, position.Z, 0);
-            InternalDraw(offset, Screen.ScaledWidth, Screen.Height);
-            Function.Call(Hash.CLEAR_DRAW_ORIGIN);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseDrawOrigin(position);
+            InternalDraw(recorder, offset, Screen.ScaledWidth, Screen.Height);
+            recorder.EndElement();
         }
 
-        void InternalDraw(SizeF offset, float screenWidth, float screenHeight)
+        void InternalDraw(DrawList.Recorder recorder, SizeF offset, float screenWidth, float screenHeight)
         {
-            if (!Enabled || !Function.Call<bool>(Hash.HAS_STREAMED_TEXTURE_DICT_LOADED, _textureDict))
+            if (!Enabled || _disposed || !recorder.IsTextureDictLoaded(_hashedDictName, _pinnedDict))
             {
                 return;
             }
@@ -327,6 +337,9 @@ namespace GTA.UI
                 positionY += scaleY * 0.5f;
             }
 
+            recorder.KeepAlive(_pinnedNames);
+
+            SHVDN.NativeCallBatch batch = recorder.Batch;
             if (TextureCoordinates != RectangleF.Empty)
             {
                 float u1 = TextureCoordinates.Top;
@@ -334,12 +347,38 @@ namespace GTA.UI
                 float u2 = TextureCoordinates.Right;
                 float v2 = TextureCoordinates.Bottom;
 
-                Function.Call(Hash.DRAW_SPRITE_ARX_WITH_UV, _pinnedDict, _pinnedName, positionX, positionY, scaleX, scaleY, u1, v1, u2, v2, Rotation, Color.R, Color.G, Color.B, Color.A);
+                batch.BeginCall((ulong)Hash.DRAW_SPRITE_ARX_WITH_UV);
+                PushTextureAndRect(batch, positionX, positionY, scaleX, scaleY);
+                batch.PushArgument(u1);
+                batch.PushArgument(v1);
+                batch.PushArgument(u2);
+                batch.PushArgument(v2);
+                PushRotationAndColor(batch);
 
                 return;
             }
 
-            Function.Call(Hash.DRAW_SPRITE, _pinnedDict, _pinnedName, positionX, positionY, scaleX, scaleY, Rotation, Color.R, Color.G, Color.B, Color.A);
+            batch.BeginCall((ulong)Hash.DRAW_SPRITE);
+            PushTextureAndRect(batch, positionX, positionY, scaleX, scaleY);
+            PushRotationAndColor(batch);
+        }
+
+        private void PushTextureAndRect(SHVDN.NativeCallBatch batch, float positionX, float positionY, float scaleX, float scaleY)
+        {
+            batch.PushArgument(_pinnedDict);
+            batch.PushArgument(_pinnedName);
+            batch.PushArgument(positionX);
+            batch.PushArgument(positionY);
+            batch.PushArgument(scaleX);
+            batch.PushArgument(scaleY);
+        }
+        private void PushRotationAndColor(SHVDN.NativeCallBatch batch)
+        {
+            batch.PushArgument(Rotation);
+            batch.PushArgument((int)Color.R);
+            batch.PushArgument((int)Color.G);
+            batch.PushArgument((int)Color.B);
+            batch.PushArgument((int)Color.A);
         }
     }
 }
@@ -10,6 +10,7 @@ using System.Collections.Generic;
 using System.Drawing;
 using System.Runtime.InteropServices;
 using System.Text;
+using System.Threading;
 
 namespace GTA.UI
 {
@@ -90,7 +91,6 @@ namespace GTA.UI
         /// <param name="wrapWidth">Sets how many horizontal pixel to draw before wrapping the <see cref="TextElement"/> on the next line down.</param>
         public TextElement(string caption, PointF position, float scale, Color color, Font font, Alignment alignment, bool shadow, bool outline, float wrapWidth)
         {
-            _pinnedText = new List<IntPtr>();
             Enabled = true;
             Caption = caption;
             Position = position;
@@ -103,17 +103,155 @@ namespace GTA.UI
             WrapWidth = wrapWidth;
         }
 
-        ~TextElement()
+        /// <summary>
+        /// UTF-8 strings in unmanaged memory, such as the chunks of a caption or the texture names of a
+        /// <see cref="Sprite"/>. The <see cref="DrawList"/> of any script may still reference the strings after their
+        /// owner released them, so the memory is freed once the last queued draw is submitted.
+        /// </summary>
+        internal sealed class PinnedText
+        {
+            private IntPtr[] _chunks;
+            private int _queueReferenceCount;
+            private volatile bool _releaseRequested;
+
+            internal PinnedText(string text)
+            {
+                var chunks = new List<IntPtr>();
+                SHVDN.NativeFunc.PushLongString(text, (string str) => chunks.Add(AllocString(str)));
+                _chunks = chunks.ToArray();
+            }
+            private PinnedText(IntPtr[] chunks)
+            {
+                _chunks = chunks;
+            }
+
+            /// <summary>
+            /// Pins each of the given strings as a whole instead of splitting it into chunks.
+            /// </summary>
+            internal static PinnedText FromStrings(params string[] strings)
+            {
+                return new PinnedText(Array.ConvertAll(strings, AllocString));
+            }
+
+            private static IntPtr AllocString(string str)
+            {
+                byte[] data = Encoding.UTF8.GetBytes(str + "\0");
+                IntPtr ptr = Marshal.AllocCoTaskMem(data.Length);
+                Marshal.Copy(data, 0, ptr, data.Length);
+                return ptr;
+            }
+
+            ~PinnedText()
+            {
+                Free();
+            }
+
+            internal IntPtr[] Chunks => _chunks;
+
+            // The recorders of different scripts can queue the same strings, and scripts may run on their own threads
+            internal void AddQueueReference()
+            {
+                Interlocked.Increment(ref _queueReferenceCount);
+            }
+            internal void RemoveQueueReference()
+            {
+                if (Interlocked.Decrement(ref _queueReferenceCount) == 0 && _releaseRequested)
+                {
+                    Free();
+                }
+            }
+
+            internal void Release()
+            {
+                _releaseRequested = true;
+                if (Volatile.Read(ref _queueReferenceCount) == 0)
+                {
+                    Free();
+                }
+            }
+
+            private void Free()
+            {
+                // Both the last dequeue and the release may get here at the same time, but only one frees the strings
+                IntPtr[] chunks = Interlocked.Exchange(ref _chunks, null);
+                if (chunks == null)
+                {
+                    return;
+                }
+
+                foreach (IntPtr ptr in chunks)
+                {
+                    Marshal.FreeCoTaskMem(ptr);
+                }
+                GC.SuppressFinalize(this);
+            }
+
+            internal void PushComponents(SHVDN.NativeCallBatch batch)
+            {
+                foreach (IntPtr ptr in _chunks)
+                {
+                    batch.BeginCall((ulong)Hash.ADD_TEXT_COMPONENT_SUBSTRING_PLAYER_NAME);
+                    batch.PushArgument(ptr);
+                }
+            }
+        }
+
+        /// <summary>
+        /// The cached result of <c>END_TEXT_COMMAND_GET_NUMBER_OF_LINES_FOR_STRING</c> and the inputs it was measured
+        /// with other than the ones tracked by <see cref="_layoutVersion"/>.
+        /// </summary>
+        private struct LineCountCacheEntry
+        {
+            internal int _layoutVersion;
+            internal float _screenWidth;
+            internal float _aspectRatio;
+            internal PointF _position;
+            internal int _lineCount;
+        }
+
+        private struct StringWidthCacheKey : IEquatable<StringWidthCacheKey>
         {
-            foreach (IntPtr ptr in _pinnedText)
+            internal string _text;
+            internal Font _font;
+            internal float _scale;
+            internal float _aspectRatio;
+
+            public bool Equals(StringWidthCacheKey other) => _text == other._text && _font == other._font
+                && _scale == other._scale && _aspectRatio == other._aspectRatio;
+            public override bool Equals(object obj) => obj is StringWidthCacheKey other && Equals(other);
+            public override int GetHashCode()
             {
-                Marshal.FreeCoTaskMem(ptr); //free any existing allocated text
+                unchecked
+                {
+                    int hash = _text?.GetHashCode() ?? 0;
+                    hash = (hash * 397) ^ (int)_font;
+                    hash = (hash * 397) ^ _scale.GetHashCode();
+                    return (hash * 397) ^ _aspectRatio.GetHashCode();
+                }
             }
-            _pinnedText.Clear();
         }
 
+        private const int MaxStringWidthCacheCount = 1024;
+        private static readonly Dictionary<StringWidthCacheKey, float> s_stringWidthCache = new();
+
+        [ThreadStatic]
+        private static SHVDN.NativeCallBatch s_measureBatch;
+
         private string _caption;
-        private readonly List<IntPtr> _pinnedText;
+        private PinnedText _pinnedText;
+        private Font _font;
+        private float _scale;
+        private float _wrapWidth;
+        private Alignment _alignment;
+
+        // Bumped whenever an input of the text layout other than the position changes, so the cached metrics below
+        // can be validated without comparing the caption strings
+        private int _layoutVersion;
+        private int _cachedWidthLayoutVersion = -1;
+        private float _cachedWidthAspectRatio;
+        private float _cachedNormalizedWidth;
+        private LineCountCacheEntry _cachedLineCount = new() { _layoutVersion = -1 };
+        private LineCountCacheEntry _cachedScaledLineCount = new() { _layoutVersion = -1 };
 
         /// <summary>
         /// Gets or sets a value indicating whether this <see cref="TextElement" /> will be drawn.
@@ -156,7 +294,15 @@ namespace GTA.UI
         /// </value>
         public float Scale
         {
-            get; set;
+            get => _scale;
+            set
+            {
+                if (_scale != value)
+                {
+                    _scale = value;
+                    _layoutVersion++;
+                }
+            }
         }
         /// <summary>
         /// Gets or sets the font of this <see cref="TextElement"/>.
@@ -166,7 +312,15 @@ namespace GTA.UI
         /// </value>
         public Font Font
         {
-            get; set;
+            get => _font;
+            set
+            {
+                if (_font != value)
+                {
+                    _font = value;
+                    _layoutVersion++;
+                }
+            }
         }
         /// <summary>
         /// Gets or sets the text to draw in this <see cref="TextElement"/>.
@@ -179,20 +333,15 @@ namespace GTA.UI
             get => _caption;
             set
             {
-                _caption = value;
-                foreach (IntPtr ptr in _pinnedText)
+                if (_pinnedText != null && _caption == value)
                 {
-                    Marshal.FreeCoTaskMem(ptr); //free any existing allocated text
+                    return;
                 }
-                _pinnedText.Clear();
 
-                SHVDN.NativeFunc.PushLongString(value, (string str) =>
-                {
-                    byte[] data = Encoding.UTF8.GetBytes(str + "\0");
-                    IntPtr next = Marshal.AllocCoTaskMem(data.Length);
-                    Marshal.Copy(data, 0, next, data.Length);
-                    _pinnedText.Add(next);
-                });
+                _caption = value;
+                _pinnedText?.Release();
+                _pinnedText = new PinnedText(value);
+                _layoutVersion++;
             }
         }
 
@@ -204,7 +353,15 @@ namespace GTA.UI
         /// </value>
         public Alignment Alignment
         {
-            get; set;
+            get => _alignment;
+            set
+            {
+                if (_alignment != value)
+                {
+                    _alignment = value;
+                    _layoutVersion++;
+                }
+            }
         }
         /// <summary>
         /// Gets or sets a value indicating whether this <see cref="TextElement"/> is drawn with a shadow effect.
@@ -234,7 +391,15 @@ namespace GTA.UI
         /// </value>
         public float WrapWidth
         {
-            get; set;
+            get => _wrapWidth;
+            set
+            {
+                if (_wrapWidth != value)
+                {
+                    _wrapWidth = value;
+                    _layoutVersion++;
+                }
+            }
         }
         /// <summary>
         /// Gets or sets a value indicating whether the alignment of this <see cref="TextElement" /> is centered.
@@ -258,103 +423,185 @@ namespace GTA.UI
         /// <summary>
         /// Measures how many pixels in the horizontal axis this <see cref="TextElement"/> will use when drawn	against a 1280 pixel base
         /// </summary>
-        public float Width
-        {
-            get
-            {
-                Function.Call(Hash.BEGIN_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT, SHVDN.NativeMemory.CellEmailBcon);
-
-                foreach (IntPtr ptr in _pinnedText)
-                {
-                    Function.Call(Hash.ADD_TEXT_COMPONENT_SUBSTRING_PLAYER_NAME, ptr);
-                }
-
-                Function.Call(Hash.SET_TEXT_FONT, (int)Font);
-                Function.Call(Hash.SET_TEXT_SCALE, Scale, Scale);
-
-                return Screen.Width * Function.Call<float>(Hash.END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT, 1);
-            }
-        }
+        /// <remarks>
+        /// The measured value is cached until <see cref="Caption"/>, <see cref="Font"/>, <see cref="Scale"/>,
+        /// <see cref="WrapWidth"/>, <see cref="Alignment"/> or the screen aspect ratio changes.
+        /// </remarks>
+        public float Width => Screen.Width * GetNormalizedWidth(Screen.AspectRatio);
         /// <summary>
         /// Measures how many pixels in the horizontal axis this <see cref="TextElement"/> will use when drawn against a <see cref="ScaledWidth"/> pixel base
         /// </summary>
+        /// <remarks>
+        /// The measured value is cached until <see cref="Caption"/>, <see cref="Font"/>, <see cref="Scale"/>,
+        /// <see cref="WrapWidth"/>, <see cref="Alignment"/> or the screen aspect ratio changes.
+        /// </remarks>
         public float ScaledWidth
         {
             get
             {
-                Function.Call(Hash.BEGIN_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT, SHVDN.NativeMemory.CellEmailBcon);
-
-                foreach (IntPtr ptr in _pinnedText)
-                {
-                    Function.Call(Hash.ADD_TEXT_COMPONENT_SUBSTRING_PLAYER_NAME, ptr);
-                }
-
-                Function.Call(Hash.SET_TEXT_FONT, (int)Font);
-                Function.Call(Hash.SET_TEXT_SCALE, Scale, Scale);
-
-                return Screen.ScaledWidth * Function.Call<float>(Hash.END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT, 1);
+                float aspectRatio = Screen.AspectRatio;
+                return Screen.Height * aspectRatio * GetNormalizedWidth(aspectRatio);
             }
         }
 
         /// <summary>
         /// Measures how many lines the text string will use when drawn on screen against a <see cref="Screen.Width"/> pixel base.
         /// </summary>
-        public int LineCount => CalculateLineCountInternal(Screen.Width, Screen.Height);
+        /// <remarks>
+        /// The measured value is cached until <see cref="Position"/> or one of the inputs <see cref="Width"/> depends on changes.
+        /// </remarks>
+        public int LineCount => GetLineCount(ref _cachedLineCount, Screen.Width, Screen.AspectRatio);
         /// <summary>
         /// Measures how many lines the text string will use when drawn on screen against a <see cref="Screen.ScaledWidth"/> pixel base.
         /// </summary>
-        public int ScaledLineCount => CalculateLineCountInternal(Screen.ScaledWidth, Screen.Height);
+        /// <remarks>
+        /// The measured value is cached until <see cref="Position"/> or one of the inputs <see cref="Width"/> depends on changes.
+        /// </remarks>
+        public int ScaledLineCount
+        {
+            get
+            {
+                float aspectRatio = Screen.AspectRatio;
+                return GetLineCount(ref _cachedScaledLineCount, Screen.Height * aspectRatio, aspectRatio);
+            }
+        }
+
+        private float GetNormalizedWidth(float aspectRatio)
+        {
+            if (_cachedWidthLayoutVersion == _layoutVersion && _cachedWidthAspectRatio == aspectRatio)
+            {
+                return _cachedNormalizedWidth;
+            }
+
+            SHVDN.NativeCallBatch batch = GetMeasureBatch();
+            batch.BeginCall((ulong)Hash.BEGIN_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT);
+            batch.PushArgument(SHVDN.NativeMemory.CellEmailBcon);
+            _pinnedText.PushComponents(batch);
+            PushFontAndScale(batch, Font, Scale);
+            batch.BeginCall((ulong)Hash.END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT);
+            batch.PushArgument(true);
+
+            _cachedNormalizedWidth = InvokeMeasureBatch<float>(batch);
+            _cachedWidthLayoutVersion = _layoutVersion;
+            _cachedWidthAspectRatio = aspectRatio;
+
+            return _cachedNormalizedWidth;
+        }
+
+        private int GetLineCount(ref LineCountCacheEntry cache, float screenWidth, float aspectRatio)
+        {
+            if (cache._layoutVersion == _layoutVersion && cache._screenWidth == screenWidth
+                && cache._aspectRatio == aspectRatio && cache._position == Position)
+            {
+                return cache._lineCount;
+            }
+
+            cache._lineCount = CalculateLineCountInternal(screenWidth, Screen.Height);
+            cache._layoutVersion = _layoutVersion;
+            cache._screenWidth = screenWidth;
+            cache._aspectRatio = aspectRatio;
+            cache._position = Position;
+
+            return cache._lineCount;
+        }
 
         private int CalculateLineCountInternal(float screenWidth, float screenHeight)
         {
-            Function.Call(Hash.SET_TEXT_FONT, (int)Font);
-            Function.Call(Hash.SET_TEXT_SCALE, Scale, Scale);
+            SHVDN.NativeCallBatch batch = GetMeasureBatch();
+            PushFontAndScale(batch, Font, Scale);
 
             float x = Position.X / screenWidth;
             float y = Position.Y / screenHeight;
-            float w = WrapWidth / screenWidth;
 
-            bool shouldSetWrapToDefault = false;
+            bool shouldSetWrapToDefault = PushWrap(batch, x, WrapWidth / screenWidth);
+            batch.BeginCall((ulong)Hash.SET_TEXT_JUSTIFICATION);
+            batch.PushArgument((int)Alignment);
+
+            batch.BeginCall((ulong)Hash.BEGIN_TEXT_COMMAND_GET_NUMBER_OF_LINES_FOR_STRING);
+            batch.PushArgument(SHVDN.NativeMemory.CellEmailBcon);
+            _pinnedText.PushComponents(batch);
+            batch.BeginCall((ulong)Hash.END_TEXT_COMMAND_GET_NUMBER_OF_LINES_FOR_STRING);
+            batch.PushArgument(x);
+            batch.PushArgument(y);
 
+            int result = InvokeMeasureBatch<int>(batch);
+
+            if (shouldSetWrapToDefault)
+            {
+                // The static start x value (that 2nd argument changes) is set to 0 and the static end x value (that 2nd argument changes) is set to 1f when the exe gets loaded
+                Function.Call(Hash.SET_TEXT_WRAP, 0f, 1f);
+            }
+
+            return result;
+        }
+
+        private static SHVDN.NativeCallBatch GetMeasureBatch()
+        {
+            SHVDN.NativeCallBatch batch = s_measureBatch ??= new SHVDN.NativeCallBatch();
+            batch.Clear();
+            return batch;
+        }
+        private static unsafe T InvokeMeasureBatch<T>(SHVDN.NativeCallBatch batch) where T : unmanaged
+        {
+            try
+            {
+                return *(T*)SHVDN.NativeFunc.InvokeBatch(batch);
+            }
+            finally
+            {
+                batch.Clear();
+            }
+        }
+
+        private static void PushFontAndScale(SHVDN.NativeCallBatch batch, Font font, float scale)
+        {
+            batch.BeginCall((ulong)Hash.SET_TEXT_FONT);
+            batch.PushArgument((int)font);
+            batch.BeginCall((ulong)Hash.SET_TEXT_SCALE);
+            batch.PushArgument(scale);
+            batch.PushArgument(scale);
+        }
+        /// <summary>
+        /// Pushes a <c>SET_TEXT_WRAP</c> call for the current <see cref="Alignment"/> and <see cref="WrapWidth"/> if one is needed.
+        /// </summary>
+        /// <returns><see langword="true" /> if a call was pushed; otherwise, <see langword="false" />.</returns>
+        private bool PushWrap(SHVDN.NativeCallBatch batch, float x, float w)
+        {
+            float start, end;
             if (WrapWidth > 0.0f)
             {
                 switch (Alignment)
                 {
                     case Alignment.Center:
-                        Function.Call(Hash.SET_TEXT_WRAP, x - (w / 2), x + (w / 2));
+                        start = x - (w / 2);
+                        end = x + (w / 2);
                         break;
                     case Alignment.Left:
-                        Function.Call(Hash.SET_TEXT_WRAP, x, x + w);
+                        start = x;
+                        end = x + w;
                         break;
                     case Alignment.Right:
-                        Function.Call(Hash.SET_TEXT_WRAP, x - w, x);
+                        start = x - w;
+                        end = x;
                         break;
+                    default:
+                        return false;
                 }
-                shouldSetWrapToDefault = true;
             }
             else if (Alignment == Alignment.Right)
             {
-                Function.Call(Hash.SET_TEXT_WRAP, 0.0f, x);
-                shouldSetWrapToDefault = true;
+                start = 0.0f;
+                end = x;
             }
-            Function.Call(Hash.SET_TEXT_JUSTIFICATION, (int)Alignment);
-
-            Function.Call(Hash.BEGIN_TEXT_COMMAND_GET_NUMBER_OF_LINES_FOR_STRING, SHVDN.NativeMemory.CellEmailBcon);
-
-            foreach (IntPtr ptr in _pinnedText)
+            else
             {
-                Function.Call(Hash.ADD_TEXT_COMPONENT_SUBSTRING_PLAYER_NAME, ptr);
+                return false;
             }
 
-            int result = Function.Call<int>(Hash.END_TEXT_COMMAND_GET_NUMBER_OF_LINES_FOR_STRING, x, y);
-
-            if (shouldSetWrapToDefault)
-            {
-                // The static start x value (that 2nd argument changes) is set to 0 and the static end x value (that 2nd argument changes) is set to 1f when the exe gets loaded
-                Function.Call(Hash.SET_TEXT_WRAP, 0f, 1f);
-            }
-
-            return result;
+            batch.BeginCall((ulong)Hash.SET_TEXT_WRAP);
+            batch.PushArgument(start);
+            batch.PushArgument(end);
+            return true;
         }
 
         /// <summary>
@@ -368,12 +615,7 @@ namespace GTA.UI
         /// </returns>
         public static float GetStringWidth(string text, Font font = Font.ChaletLondon, float scale = 1.0f)
         {
-            Function.Call(Hash.BEGIN_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT, SHVDN.NativeMemory.CellEmailBcon);
-            SHVDN.NativeFunc.PushLongString(text);
-            Function.Call(Hash.SET_TEXT_FONT, (int)font);
-            Function.Call(Hash.SET_TEXT_SCALE, scale, scale);
-
-            return Screen.Width * Function.Call<float>(Hash.END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT, 1);
+            return Screen.Width * GetNormalizedStringWidth(text, font, scale, Screen.AspectRatio);
         }
         /// <summary>
         /// Measures how many pixels in the horizontal axis the string will use when drawn
@@ -386,12 +628,38 @@ namespace GTA.UI
         /// </returns>
         public static float GetScaledStringWidth(string text, Font font = Font.ChaletLondon, float scale = 1.0f)
         {
+            float aspectRatio = Screen.AspectRatio;
+            return Screen.Height * aspectRatio * GetNormalizedStringWidth(text, font, scale, aspectRatio);
+        }
+
+        private static float GetNormalizedStringWidth(string text, Font font, float scale, float aspectRatio)
+        {
+            var key = new StringWidthCacheKey { _text = text, _font = font, _scale = scale, _aspectRatio = aspectRatio };
+            lock (s_stringWidthCache)
+            {
+                if (s_stringWidthCache.TryGetValue(key, out float cachedWidth))
+                {
+                    return cachedWidth;
+                }
+            }
+
             Function.Call(Hash.BEGIN_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT, SHVDN.NativeMemory.CellEmailBcon);
             SHVDN.NativeFunc.PushLongString(text);
             Function.Call(Hash.SET_TEXT_FONT, (int)font);
             Function.Call(Hash.SET_TEXT_SCALE, scale, scale);
+            float width = Function.Call<float>(Hash.END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT, 1);
+
+            lock (s_stringWidthCache)
+            {
+                // Callers tend to measure a bounded set of labels, so simply start over when that assumption breaks
+                if (s_stringWidthCache.Count >= MaxStringWidthCacheCount)
+                {
+                    s_stringWidthCache.Clear();
+                }
+                s_stringWidthCache[key] = width;
+            }
 
-            return Screen.ScaledWidth * Function.Call<float>(Hash.END_TEXT_COMMAND_GET_SCREEN_WIDTH_OF_DISPLAY_TEXT, 1);
+            return width;
         }
 
         /// <summary>
@@ -407,7 +675,11 @@ namespace GTA.UI
         /// <param name="offset">The offset to shift the draw position of this <see cref="TextElement" /> using a 1280*720 pixel base.</param>
         public virtual void Draw(SizeF offset)
         {
-            InternalDraw(offset, Screen.Width, Screen.Height);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseScreenOrigin();
+            InternalDraw(recorder, offset, Screen.Width, Screen.Height);
+            recorder.EndElement();
         }
 
         /// <summary>
@@ -423,7 +695,11 @@ namespace GTA.UI
         /// <param name="offset">The offset to shift the draw position of this <see cref="TextElement" /> using a <see cref="Screen.ScaledWidth" />*720 pixel base.</param>
         public virtual void ScaledDraw(SizeF offset)
         {
-            InternalDraw(offset, Screen.ScaledWidth, Screen.Height);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseScreenOrigin();
+            InternalDraw(recorder, offset, Screen.ScaledWidth, Screen.Height);
+            recorder.EndElement();
         }
 
         /// <summary>
@@ -441,9 +717,11 @@ namespace GTA.UI
         /// <param name="offset">The offset to shift the draw position of this <see cref="TextElement"/> using a 1280*720 pixel base.</param>
         public virtual void WorldDraw(Vector3 position, SizeF offset)
         {
-            Function.Call(Hash.SET_DRAW_ORIGIN, position.X, position.Y, position.Z, 0);
-            InternalDraw(offset, Screen.Width, Screen.Height);
-            Function.Call(Hash.CLEAR_DRAW_ORIGIN);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseDrawOrigin(position);
+            InternalDraw(recorder, offset, Screen.Width, Screen.Height);
+            recorder.EndElement();
         }
         /// <summary>
         /// Draws this <see cref="TextElement"/> this frame at the specified <see cref="Vector3"/> position and offset using the width returned in <see cref="Screen.ScaledWidth"/>.
@@ -460,12 +738,14 @@ namespace GTA.UI
         /// <param name="offset">The offset to shift the draw position of this <see cref="TextElement"/> using a <see cref="Screen.ScaledWidth"/>*720 pixel base.</param>
         public virtual void WorldScaledDraw(Vector3 position, SizeF offset)
         {
-            Function.Call(Hash.SET_DRAW_ORIGIN, position.X, position.Y, position.Z, 0);
-            InternalDraw(offset, Screen.ScaledWidth, Screen.Height);
-            Function.Call(Hash.CLEAR_DRAW_ORIGIN);
+            DrawList.Recorder recorder = DrawList.Current;
+            recorder.BeginElement();
+            recorder.UseDrawOrigin(position);
+            InternalDraw(recorder, offset, Screen.ScaledWidth, Screen.Height);
+            recorder.EndElement();
         }
 
-        void InternalDraw(SizeF offset, float screenWidth, float screenHeight)
+        void InternalDraw(DrawList.Recorder recorder, SizeF offset, float screenWidth, float screenHeight)
         {
             if (!Enabled)
             {
@@ -476,48 +756,36 @@ namespace GTA.UI
             float y = (Position.Y + offset.Height) / screenHeight;
             float w = WrapWidth / screenWidth;
 
+            // The game resets all the text formatting after each displayed text command, so the formatting calls
+            // have to be pushed for every element even if the values did not change
+            SHVDN.NativeCallBatch batch = recorder.Batch;
             if (Shadow)
             {
-                Function.Call(Hash.SET_TEXT_DROP_SHADOW);
+                batch.BeginCall((ulong)Hash.SET_TEXT_DROP_SHADOW);
             }
             if (Outline)
             {
-                Function.Call(Hash.SET_TEXT_OUTLINE);
-            }
-
-            Function.Call(Hash.SET_TEXT_FONT, (int)Font);
-            Function.Call(Hash.SET_TEXT_SCALE, Scale, Scale);
-            Function.Call(Hash.SET_TEXT_COLOUR, Color.R, Color.G, Color.B, Color.A);
-            Function.Call(Hash.SET_TEXT_JUSTIFICATION, (int)Alignment);
-
-            if (WrapWidth > 0.0f)
-            {
-                switch (Alignment)
-                {
-                    case Alignment.Center:
-                        Function.Call(Hash.SET_TEXT_WRAP, x - (w / 2), x + (w / 2));
-                        break;
-                    case Alignment.Left:
-                        Function.Call(Hash.SET_TEXT_WRAP, x, x + w);
-                        break;
-                    case Alignment.Right:
-                        Function.Call(Hash.SET_TEXT_WRAP, x - w, x);
-                        break;
-                }
-            }
-            else if (Alignment == Alignment.Right)
-            {
-                Function.Call(Hash.SET_TEXT_WRAP, 0.0f, x);
-            }
-
-            Function.Call(Hash.BEGIN_TEXT_COMMAND_DISPLAY_TEXT, SHVDN.NativeMemory.CellEmailBcon);
-
-            foreach (IntPtr ptr in _pinnedText)
-            {
-                Function.Call(Hash.ADD_TEXT_COMPONENT_SUBSTRING_PLAYER_NAME, ptr);
+                batch.BeginCall((ulong)Hash.SET_TEXT_OUTLINE);
             }
 
-            Function.Call(Hash.END_TEXT_COMMAND_DISPLAY_TEXT, x, y);
+            PushFontAndScale(batch, Font, Scale);
+            batch.BeginCall((ulong)Hash.SET_TEXT_COLOUR);
+            batch.PushArgument((int)Color.R);
+            batch.PushArgument((int)Color.G);
+            batch.PushArgument((int)Color.B);
+            batch.PushArgument((int)Color.A);
+            batch.BeginCall((ulong)Hash.SET_TEXT_JUSTIFICATION);
+            batch.PushArgument((int)Alignment);
+
+            PushWrap(batch, x, w);
+
+            batch.BeginCall((ulong)Hash.BEGIN_TEXT_COMMAND_DISPLAY_TEXT);
+            batch.PushArgument(SHVDN.NativeMemory.CellEmailBcon);
+            _pinnedText.PushComponents(batch);
+            recorder.KeepAlive(_pinnedText);
+            batch.BeginCall((ulong)Hash.END_TEXT_COMMAND_DISPLAY_TEXT);
+            batch.PushArgument(x);
+            batch.PushArgument(y);
         }
     }
 }
@@ -0,0 +1,36 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+namespace GTA
+{
+    /// <summary>
+    /// The <see cref="Blip"/>s to enumerate in a <see langword="foreach"/> statement without allocating an array.
+    /// Each enumeration gets the <see cref="Blip"/>s that exist when it starts, so it can be enumerated more than once.
+    /// </summary>
+    public readonly struct BlipEnumerable
+    {
+        private readonly SHVDN.FVector3? _position;
+        private readonly float _radius;
+        private readonly SHVDN.BlipSpriteMask _spriteMask;
+
+        internal BlipEnumerable(SHVDN.FVector3? position, float radius, SHVDN.BlipSpriteMask spriteMask)
+        {
+            _position = position;
+            _radius = radius;
+            _spriteMask = spriteMask;
+        }
+
+        /// <summary>
+        /// Copies the handles of the <see cref="Blip"/>s into a pooled buffer, which the returned enumerator returns to
+        /// the pool when it is disposed.
+        /// </summary>
+        public BlipEnumerator GetEnumerator()
+        {
+            int[] handles = SHVDN.HandleBufferPool.Rent(0);
+            int count = SHVDN.NativeMemory.CopyNonCriticalRadarBlipHandles(ref handles, _position, _radius, _spriteMask ?? SHVDN.BlipSpriteMask.All);
+            return new BlipEnumerator(handles, count);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+
+namespace GTA
+{
+    /// <summary>
+    /// Enumerates the <see cref="Blip"/>s that existed when <see cref="BlipEnumerable.GetEnumerator"/> was called.
+    /// Dispose it once, which the <see langword="foreach"/> statement does, to return its buffer to a shared pool.
+    /// </summary>
+    public struct BlipEnumerator : IDisposable
+    {
+        private int[] _handles;
+        private readonly int _count;
+        private int _index;
+
+        internal BlipEnumerator(int[] handles, int count)
+        {
+            _handles = handles;
+            _count = count;
+            _index = -1;
+        }
+
+        /// <summary>
+        /// Gets the number of <see cref="Blip"/>s this enumerator enumerates.
+        /// </summary>
+        public int Count => _count;
+
+        public Blip Current => new(_handles[_index]);
+
+        public bool MoveNext() => _handles != null && ++_index < _count;
+
+        public void Dispose()
+        {
+            SHVDN.HandleBufferPool.Return(_handles);
+            _handles = null;
+        }
+    }
+}
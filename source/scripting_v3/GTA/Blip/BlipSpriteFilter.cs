@@ -0,0 +1,46 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+
+namespace GTA
+{
+    /// <summary>
+    /// A precomputed set of <see cref="BlipSprite"/>s to filter <see cref="Blip"/>s with.
+    /// Create one once and reuse it, so filtering does not convert the sprites every time.
+    /// </summary>
+    public sealed class BlipSpriteFilter
+    {
+        /// <summary>
+        /// A filter that includes every <see cref="Blip"/>.
+        /// </summary>
+        public static readonly BlipSpriteFilter All = new(SHVDN.BlipSpriteMask.All);
+
+        /// <summary>
+        /// Creates a filter that includes the <see cref="Blip"/>s with any of the given sprites.
+        /// </summary>
+        /// <param name="sprites">The sprites to include, leave blank to include every <see cref="Blip"/>.</param>
+        public BlipSpriteFilter(params BlipSprite[] sprites)
+        {
+            if (sprites == null)
+            {
+                throw new ArgumentNullException(nameof(sprites));
+            }
+
+            Mask = new SHVDN.BlipSpriteMask(Array.ConvertAll(sprites, sprite => (int)sprite));
+        }
+        private BlipSpriteFilter(SHVDN.BlipSpriteMask mask)
+        {
+            Mask = mask;
+        }
+
+        internal SHVDN.BlipSpriteMask Mask { get; }
+
+        /// <summary>
+        /// Determines whether this filter includes a <see cref="BlipSprite"/>.
+        /// </summary>
+        public bool Contains(BlipSprite sprite) => Mask.Contains((int)sprite);
+    }
+}
@@ -0,0 +1,26 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+namespace GTA
+{
+    /// <summary>
+    /// The <see cref="Checkpoint"/>s to enumerate in a <see langword="foreach"/> statement without allocating an array.
+    /// Each enumeration gets the <see cref="Checkpoint"/>s that exist when it starts, so it can be enumerated more than
+    /// once.
+    /// </summary>
+    public readonly struct CheckpointEnumerable
+    {
+        /// <summary>
+        /// Copies the handles of the <see cref="Checkpoint"/>s into a pooled buffer, which the returned enumerator
+        /// returns to the pool when it is disposed.
+        /// </summary>
+        public CheckpointEnumerator GetEnumerator()
+        {
+            int[] handles = SHVDN.HandleBufferPool.Rent(0);
+            int count = SHVDN.NativeMemory.CopyCheckpointHandles(ref handles);
+            return new CheckpointEnumerator(handles, count);
+        }
+    }
+}
@@ -52,7 +52,10 @@ namespace GTA
         /// </summary>
         public void Request()
         {
-            Function.Call(Hash.REQUEST_CLIP_SET, Name);
+            if (Streaming.Acquire(SHVDN.StreamingAssetType.ClipSet, 0, Name) == null)
+            {
+                Function.Call(Hash.REQUEST_CLIP_SET, Name);
+            }
         }
         /// <summary>
         /// Attempts to load this <see cref="ClipSet"/> into memory for a given period of time.
@@ -61,23 +64,30 @@ namespace GTA
         /// <returns><see langword="true" /> if this <see cref="ClipSet"/> is loaded; otherwise, <see langword="false" />.</returns>
         public bool Request(int timeout)
         {
-            Request();
-
-            int startTime = Environment.TickCount;
-            int maxElapsedTime = timeout >= 0 ? timeout : int.MaxValue;
-
-            while (!IsLoaded)
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.ClipSet, 0, Name);
+            if (request == null)
             {
-                Script.Yield();
-                Request();
+                Function.Call(Hash.REQUEST_CLIP_SET, Name);
+                return IsLoaded;
+            }
 
-                if (Environment.TickCount - startTime >= maxElapsedTime)
-                {
-                    return false;
-                }
+            return Streaming.Wait(request, timeout);
+        }
+        /// <summary>
+        /// Attempts to load this <see cref="ClipSet"/> into memory without waiting for it.
+        /// Scripts that request the same <see cref="ClipSet"/> share one <see cref="StreamingRequest"/>.
+        /// </summary>
+        /// <returns>The request, which can be awaited or used to register a callback.</returns>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public StreamingRequest RequestAsync()
+        {
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.ClipSet, 0, Name);
+            if (request == null)
+            {
+                throw new InvalidOperationException("Streaming requests can only be made from a script.");
             }
 
-            return true;
+            return new StreamingRequest(request);
         }
 
         /// <summary>
@@ -85,7 +95,10 @@ namespace GTA
         /// </summary>
         public void MarkAsNoLongerNeeded()
         {
-            Function.Call(Hash.REMOVE_CLIP_SET, Name);
+            if (!Streaming.Release(SHVDN.StreamingAssetType.ClipSet, 0, Name))
+            {
+                Function.Call(Hash.REMOVE_CLIP_SET, Name);
+            }
         }
 
         public bool Equals(ClipSet other)
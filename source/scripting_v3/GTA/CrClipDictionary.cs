@@ -60,7 +60,10 @@ namespace GTA
         /// </summary>
         public void Request()
         {
-            Function.Call(Hash.REQUEST_ANIM_DICT, Name);
+            if (Streaming.Acquire(SHVDN.StreamingAssetType.ClipDictionary, 0, Name) == null)
+            {
+                Function.Call(Hash.REQUEST_ANIM_DICT, Name);
+            }
         }
         /// <summary>
         /// Attempts to load this <see cref="CrClipDictionary"/> into memory for a given period of time.
@@ -69,23 +72,30 @@ namespace GTA
         /// <returns><see langword="true" /> if this <see cref="CrClipDictionary"/> is loaded; otherwise, <see langword="false" />.</returns>
         public bool Request(int timeout)
         {
-            Request();
-
-            int startTime = Environment.TickCount;
-            int maxElapsedTime = timeout >= 0 ? timeout : int.MaxValue;
-
-            while (!IsLoaded)
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.ClipDictionary, 0, Name);
+            if (request == null)
             {
-                Script.Yield();
-                Request();
+                Function.Call(Hash.REQUEST_ANIM_DICT, Name);
+                return IsLoaded;
+            }
 
-                if (Environment.TickCount - startTime >= maxElapsedTime)
-                {
-                    return false;
-                }
+            return Streaming.Wait(request, timeout);
+        }
+        /// <summary>
+        /// Attempts to load this <see cref="CrClipDictionary"/> into memory without waiting for it.
+        /// Scripts that request the same <see cref="CrClipDictionary"/> share one <see cref="StreamingRequest"/>.
+        /// </summary>
+        /// <returns>The request, which can be awaited or used to register a callback.</returns>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public StreamingRequest RequestAsync()
+        {
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.ClipDictionary, 0, Name);
+            if (request == null)
+            {
+                throw new InvalidOperationException("Streaming requests can only be made from a script.");
             }
 
-            return true;
+            return new StreamingRequest(request);
         }
 
         /// <summary>
@@ -93,7 +103,10 @@ namespace GTA
         /// </summary>
         public void MarkAsNoLongerNeeded()
         {
-            Function.Call(Hash.REMOVE_ANIM_DICT, Name);
+            if (!Streaming.Release(SHVDN.StreamingAssetType.ClipDictionary, 0, Name))
+            {
+                Function.Call(Hash.REMOVE_ANIM_DICT, Name);
+            }
         }
 
         /// <summary>
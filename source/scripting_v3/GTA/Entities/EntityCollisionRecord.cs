@@ -0,0 +1,42 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+namespace GTA
+{
+    /// <summary>
+    /// Represents a collision of a <see cref="Ped"/> or <see cref="Vehicle"/> reported by <see cref="EntityEvents"/>.
+    /// </summary>
+    public readonly struct EntityCollisionRecord
+    {
+        internal EntityCollisionRecord(Entity entity, Entity otherEntity)
+        {
+            Entity = entity;
+            OtherEntity = otherEntity;
+        }
+
+        /// <summary>
+        /// Gets the <see cref="GTA.Entity" /> that recorded the collision.
+        /// </summary>
+        public Entity Entity
+        {
+            get;
+        }
+
+        /// <summary>
+        /// Gets the <see cref="GTA.Entity" /> the <see cref="Entity" /> collided with. Can be <c>null</c> if it was
+        /// deleted before the event was delivered.
+        /// </summary>
+        public Entity OtherEntity
+        {
+            get;
+        }
+
+        public void Deconstruct(out Entity entity, out Entity otherEntity)
+        {
+            entity = Entity;
+            otherEntity = OtherEntity;
+        }
+    }
+}
@@ -0,0 +1,112 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+
+namespace GTA
+{
+    /// <summary>
+    /// Provides the damage and collision events of all <see cref="Ped"/>s and <see cref="Vehicle"/>s.
+    /// </summary>
+    /// <remarks>
+    /// The records of all <see cref="Ped"/>s and <see cref="Vehicle"/>s are scanned once per frame for all
+    /// <see cref="Script"/>s together, and only the records that changed since the previous frame are delivered.
+    /// This is much cheaper than reading <see cref="Entity.DamageRecords"/> or the collision properties of many
+    /// entities in every tick of every <see cref="Script"/>.
+    /// Events are delivered at the start of each tick of the subscribing <see cref="Script"/>, on the thread that runs it,
+    /// so the entities in them may already be deleted when the handler is called.
+    /// Each subscription reuses the <see cref="Entity"/> instances it passes for the same handle, so the same
+    /// <see cref="Entity"/> instance may be passed to many events.
+    /// </remarks>
+    public static class EntityEvents
+    {
+        /// <summary>
+        /// Subscribes the executing <see cref="Script"/> to the damage <see cref="Ped"/>s and <see cref="Vehicle"/>s take.
+        /// Only damage taken after this call is delivered.
+        /// </summary>
+        /// <param name="handler">The method that is called with each new damage record.</param>
+        /// <returns>The subscription. Dispose it to unsubscribe, which also happens when the <see cref="Script"/> is aborted.</returns>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public static ChannelSubscription SubscribeToDamage(Action<EntityDamageRecord> handler)
+        {
+            if (handler == null)
+            {
+                throw new ArgumentNullException(nameof(handler));
+            }
+
+            var entities = new EntityCache();
+            return new ChannelSubscription(SHVDN.ScriptDomain.CurrentDomain.SubscribeToEntityDamageEvents(e =>
+                handler(new EntityDamageRecord(entities.Get(e.VictimHandle), entities.Get(e.AttackerHandle), (WeaponHash)e.WeaponHash, e.GameTime))));
+        }
+
+        /// <summary>
+        /// Subscribes the executing <see cref="Script"/> to the collisions of <see cref="Ped"/>s and <see cref="Vehicle"/>s
+        /// with other <see cref="Ped"/>s, <see cref="Vehicle"/>s or <see cref="Prop"/>s.
+        /// A collision is reported in the first frame an entity touches another one, not in every frame they stay in
+        /// contact. Touching the same entity again after they were apart for at least one frame is reported again.
+        /// </summary>
+        /// <param name="handler">The method that is called with each new collision.</param>
+        /// <returns>The subscription. Dispose it to unsubscribe, which also happens when the <see cref="Script"/> is aborted.</returns>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public static ChannelSubscription SubscribeToCollisions(Action<EntityCollisionRecord> handler)
+        {
+            if (handler == null)
+            {
+                throw new ArgumentNullException(nameof(handler));
+            }
+
+            var entities = new EntityCache();
+            return new ChannelSubscription(SHVDN.ScriptDomain.CurrentDomain.SubscribeToEntityCollisionEvents(e =>
+                handler(new EntityCollisionRecord(entities.Get(e.EntityHandle), entities.Get(e.OtherEntityHandle)))));
+        }
+
+        /// <summary>
+        /// The <see cref="Entity"/> instances of a subscription by their handle. Only used on the thread of the
+        /// subscribing <see cref="Script"/>.
+        /// </summary>
+        private sealed class EntityCache
+        {
+            private const int MaxEntityCount = 256;
+
+            private readonly Dictionary<int, Entity> _entities = new();
+
+            internal Entity Get(int handle)
+            {
+                if (handle == 0)
+                {
+                    return null;
+                }
+
+                // Deleted entities are passed as null, just like Entity.FromHandle does
+                if (SHVDN.NativeMemory.GetEntityAddress(handle) == IntPtr.Zero)
+                {
+                    _entities.Remove(handle);
+                    return null;
+                }
+
+                if (_entities.TryGetValue(handle, out Entity entity))
+                {
+                    return entity;
+                }
+
+                entity = Entity.FromHandle(handle);
+                if (entity == null)
+                {
+                    return null;
+                }
+
+                // Entities are removed lazily, so start over instead of growing without a limit
+                if (_entities.Count >= MaxEntityCount)
+                {
+                    _entities.Clear();
+                }
+                _entities.Add(handle, entity);
+
+                return entity;
+            }
+        }
+    }
+}
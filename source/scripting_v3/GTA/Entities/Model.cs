@@ -420,7 +420,10 @@ namespace GTA
         /// </summary>
         public void Request()
         {
-            Function.Call(Native.Hash.REQUEST_MODEL, Hash);
+            if (Streaming.Acquire(SHVDN.StreamingAssetType.Model, Hash, null) == null)
+            {
+                Function.Call(Native.Hash.REQUEST_MODEL, Hash);
+            }
         }
         /// <summary>
         /// Attempts to load this <see cref="Model"/> into memory for a given period of time.
@@ -429,23 +432,30 @@ namespace GTA
         /// <returns><see langword="true" /> if this <see cref="Model"/> is loaded; otherwise, <see langword="false" />.</returns>
         public bool Request(int timeout)
         {
-            Request();
-
-            int startTime = Environment.TickCount;
-            int maxElapsedTime = timeout >= 0 ? timeout : int.MaxValue;
-
-            while (!IsLoaded)
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.Model, Hash, null);
+            if (request == null)
             {
-                Script.Yield();
-                Request();
+                Function.Call(Native.Hash.REQUEST_MODEL, Hash);
+                return IsLoaded;
+            }
 
-                if (Environment.TickCount - startTime >= maxElapsedTime)
-                {
-                    return false;
-                }
+            return Streaming.Wait(request, timeout);
+        }
+        /// <summary>
+        /// Attempts to load this <see cref="Model"/> into memory without waiting for it.
+        /// Scripts that request the same <see cref="Model"/> share one <see cref="StreamingRequest"/>.
+        /// </summary>
+        /// <returns>The request, which can be awaited or used to register a callback.</returns>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public StreamingRequest RequestAsync()
+        {
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.Model, Hash, null);
+            if (request == null)
+            {
+                throw new InvalidOperationException("Streaming requests can only be made from a script.");
             }
 
-            return true;
+            return new StreamingRequest(request);
         }
 
         /// <summary>
@@ -486,7 +496,10 @@ namespace GTA
         /// </summary>
         public void MarkAsNoLongerNeeded()
         {
-            Function.Call(Native.Hash.SET_MODEL_AS_NO_LONGER_NEEDED, Hash);
+            if (!Streaming.Release(SHVDN.StreamingAssetType.Model, Hash, null))
+            {
+                Function.Call(Native.Hash.SET_MODEL_AS_NO_LONGER_NEEDED, Hash);
+            }
         }
 
         public bool Equals(Model model)
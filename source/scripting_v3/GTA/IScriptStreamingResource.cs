@@ -9,6 +9,11 @@ namespace GTA
     /// A interface for streaming resources that can be requested and pinned by scripts
     /// (by increasing reference counts).
     /// </summary>
+    /// <remarks>
+    /// Requests from all scripts are merged per asset and polled once per frame by SHVDN. Each script holds an asset
+    /// at most once no matter how often it calls <see cref="Request()"/>, and the asset is only unloaded after every
+    /// script that holds it called <see cref="MarkAsNoLongerNeeded"/> or was aborted.
+    /// </remarks>
     public interface IScriptStreamingResource
     {
         bool IsLoaded
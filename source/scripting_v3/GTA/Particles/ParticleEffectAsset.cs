@@ -66,7 +66,10 @@ namespace GTA
         /// </summary>
         public void Request()
         {
-            Function.Call(Hash.REQUEST_NAMED_PTFX_ASSET, AssetName);
+            if (Streaming.Acquire(SHVDN.StreamingAssetType.ParticleEffectAsset, 0, AssetName) == null)
+            {
+                Function.Call(Hash.REQUEST_NAMED_PTFX_ASSET, AssetName);
+            }
         }
         /// <summary>
         /// Attempts to load this <see cref="ParticleEffectAsset"/> into memory so it can be used for starting <see cref="ParticleEffect"/>s.
@@ -75,23 +78,30 @@ namespace GTA
         /// <returns><see langword="true" /> if the <see cref="ParticleEffectAsset"/> is Loaded; otherwise, <see langword="false" /></returns>
         public bool Request(int timeout)
         {
-            Request();
-
-            int startTime = Environment.TickCount;
-            int maxElapsedTime = timeout >= 0 ? timeout : int.MaxValue;
-
-            while (!IsLoaded)
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.ParticleEffectAsset, 0, AssetName);
+            if (request == null)
             {
-                Script.Yield();
-                Request();
+                Function.Call(Hash.REQUEST_NAMED_PTFX_ASSET, AssetName);
+                return IsLoaded;
+            }
 
-                if (Environment.TickCount - startTime >= maxElapsedTime)
-                {
-                    return false;
-                }
+            return Streaming.Wait(request, timeout);
+        }
+        /// <summary>
+        /// Attempts to load this <see cref="ParticleEffectAsset"/> into memory without waiting for it.
+        /// Scripts that request the same <see cref="ParticleEffectAsset"/> share one <see cref="StreamingRequest"/>.
+        /// </summary>
+        /// <returns>The request, which can be awaited or used to register a callback.</returns>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public StreamingRequest RequestAsync()
+        {
+            SHVDN.StreamingRequest request = Streaming.Acquire(SHVDN.StreamingAssetType.ParticleEffectAsset, 0, AssetName);
+            if (request == null)
+            {
+                throw new InvalidOperationException("Streaming requests can only be made from a script.");
             }
 
-            return true;
+            return new StreamingRequest(request);
         }
 
         /// <summary>
@@ -99,7 +109,10 @@ namespace GTA
         /// </summary>
         public void MarkAsNoLongerNeeded()
         {
-            Function.Call(Hash.REMOVE_NAMED_PTFX_ASSET, AssetName);
+            if (!Streaming.Release(SHVDN.StreamingAssetType.ParticleEffectAsset, 0, AssetName))
+            {
+                Function.Call(Hash.REMOVE_NAMED_PTFX_ASSET, AssetName);
+            }
         }
 
         public bool Equals(ParticleEffectAsset asset)
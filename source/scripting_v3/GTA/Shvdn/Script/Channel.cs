@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+
+namespace GTA
+{
+    /// <summary>
+    /// A named channel <see cref="Script"/>s can publish messages to and subscribe to, without referencing each other.
+    /// </summary>
+    /// <typeparam name="T">
+    /// The type of the messages. Prefer small structs, which are copied into the buffer of the channel and published
+    /// without any allocation. Classes work as well, but are kept alive by the buffer until they are overwritten.
+    /// </typeparam>
+    /// <remarks>
+    /// Each channel has one owning <see cref="Script"/>, which creates it with <see cref="Create(string, int)"/>.
+    /// Messages are buffered per channel and delivered to each subscribing <see cref="Script"/> at the start of its
+    /// next tick, on the thread that runs it, so handlers do not need any synchronization.
+    /// When the owner is aborted, the channel is closed and buffered messages are dropped, but subscriptions stay and
+    /// receive messages again once another <see cref="Script"/> creates a channel with the same name.
+    /// </remarks>
+    /// <example>
+    /// <code>
+    /// public struct PlayerWantedEvent { public int Level; }
+    ///
+    /// // In the publishing script
+    /// _channel = Channel&lt;PlayerWantedEvent&gt;.Create("MyMod.PlayerWanted");
+    /// _channel.Publish(new PlayerWantedEvent { Level = 3 });
+    ///
+    /// // In a subscribing script
+    /// _subscription = Channel&lt;PlayerWantedEvent&gt;.Subscribe("MyMod.PlayerWanted", e => Notification.PostTicker($"Wanted: {e.Level}", false));
+    /// </code>
+    /// </example>
+    public sealed class Channel<T>
+    {
+        private readonly SHVDN.ScriptMessageChannel<T> _channel;
+
+        private Channel(SHVDN.ScriptMessageChannel<T> channel)
+        {
+            _channel = channel;
+        }
+
+        /// <summary>
+        /// Creates a channel owned by the executing <see cref="Script"/>.
+        /// </summary>
+        /// <param name="name">The name of the channel. Prefix it with the name of your mod to avoid conflicts.</param>
+        /// <param name="capacity">
+        /// The minimum number of messages the channel can buffer for each subscriber between two of its ticks.
+        /// Subscribers that fall further behind lose the oldest messages.
+        /// </param>
+        /// <exception cref="ArgumentException">
+        /// Another running <see cref="Script"/> owns a channel with the same name, or the channel carries another type of messages.
+        /// </exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="capacity"/> is not positive or greater than 2^30.</exception>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public static Channel<T> Create(string name, int capacity = 64)
+        {
+            return new Channel<T>(SHVDN.ScriptDomain.CurrentDomain.CreateMessageChannel<T>(name, capacity));
+        }
+
+        /// <summary>
+        /// Subscribes the executing <see cref="Script"/> to a channel.
+        /// Only messages published after this call are delivered, at the start of each tick of the <see cref="Script"/>.
+        /// </summary>
+        /// <param name="name">The name of the channel. The channel does not need to be created yet.</param>
+        /// <param name="handler">The method that is called with each message.</param>
+        /// <returns>The subscription. Dispose it to unsubscribe, which also happens when the <see cref="Script"/> is aborted.</returns>
+        /// <exception cref="ArgumentException">The channel carries another type of messages.</exception>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public static ChannelSubscription Subscribe(string name, Action<T> handler)
+        {
+            return new ChannelSubscription(SHVDN.ScriptDomain.CurrentDomain.SubscribeToMessageChannel(name, handler));
+        }
+
+        /// <summary>
+        /// Gets the name of this channel.
+        /// </summary>
+        public string Name => _channel.Name;
+
+        /// <summary>
+        /// Gets the number of messages this channel can buffer for each subscriber.
+        /// </summary>
+        public int Capacity => _channel.Capacity;
+
+        /// <summary>
+        /// Gets whether this channel accepts messages, which is the case until its owning <see cref="Script"/> is aborted.
+        /// </summary>
+        public bool IsOpen => _channel.IsOpen;
+
+        /// <summary>
+        /// Publishes a message to all subscribers of this channel. Can be called from any thread.
+        /// </summary>
+        /// <returns><see langword="true" /> if the message was published; <see langword="false" /> if the channel is closed.</returns>
+        public bool Publish(T message) => _channel.Publish(message);
+    }
+}
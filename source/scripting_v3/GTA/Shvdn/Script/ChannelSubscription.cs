@@ -0,0 +1,40 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+
+namespace GTA
+{
+    /// <summary>
+    /// A subscription of a <see cref="Script"/> to a <see cref="Channel{T}"/>.
+    /// </summary>
+    public sealed class ChannelSubscription : IDisposable
+    {
+        private readonly SHVDN.ScriptMessageSubscription _subscription;
+
+        internal ChannelSubscription(SHVDN.ScriptMessageSubscription subscription)
+        {
+            _subscription = subscription;
+        }
+
+        /// <summary>
+        /// Gets the name of the channel.
+        /// </summary>
+        public string ChannelName => _subscription.Channel.Name;
+
+        /// <summary>
+        /// Gets the number of messages that were dropped because the <see cref="Script"/> fell behind by more than the capacity of the channel.
+        /// </summary>
+        public long DroppedMessageCount => _subscription.DroppedMessageCount;
+
+        /// <summary>
+        /// Unsubscribes from the channel. Messages that have not been delivered yet are dropped.
+        /// </summary>
+        public void Dispose()
+        {
+            _subscription.Dispose();
+        }
+    }
+}
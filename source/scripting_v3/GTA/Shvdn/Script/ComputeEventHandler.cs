@@ -0,0 +1,14 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+namespace GTA
+{
+    /// <summary>
+    /// Represents the method that handles <see cref="Script.Compute"/>.
+    /// </summary>
+    /// <param name="snapshot">The state of the world at the start of the frame.</param>
+    /// <param name="natives">The script functions to call on the main thread once all scripts have computed.</param>
+    public delegate void ComputeEventHandler(in FrameSnapshot snapshot, DeferredNativeCalls natives);
+}
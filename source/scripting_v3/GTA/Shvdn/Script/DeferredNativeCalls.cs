@@ -0,0 +1,72 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using GTA.Native;
+
+namespace GTA
+{
+    /// <summary>
+    /// The script functions a <see cref="Script"/> adds during <see cref="Script.Compute"/>, which are called in order on
+    /// the main thread once the compute handlers of all scripts have returned.
+    /// </summary>
+    /// <remarks>
+    /// The return values of the calls are discarded. Read what the calls changed in <see cref="Script.Apply"/> or in
+    /// the next snapshot.
+    /// </remarks>
+    public sealed class DeferredNativeCalls
+    {
+        private readonly SHVDN.NativeCallBatch _batch;
+
+        internal DeferredNativeCalls(SHVDN.NativeCallBatch batch)
+        {
+            _batch = batch;
+        }
+
+        /// <summary>
+        /// Gets the number of calls added in this frame.
+        /// </summary>
+        public int Count => _batch.Count;
+
+        /// <summary>
+        /// Adds a call to a script function without arguments.
+        /// </summary>
+        /// <param name="hash">The hashed name of the script function.</param>
+        public void Add(Hash hash)
+        {
+            _batch.BeginCall((ulong)hash);
+        }
+        /// <summary>
+        /// Adds a call to a script function.
+        /// </summary>
+        /// <param name="hash">The hashed name of the script function.</param>
+        /// <param name="arguments">A list of input arguments passed to the script function.</param>
+        public void Add(Hash hash, params InputArgument[] arguments)
+        {
+            _batch.BeginCall((ulong)hash);
+            foreach (InputArgument argument in arguments)
+            {
+                _batch.PushArgument(argument?._data ?? 0);
+            }
+        }
+        /// <summary>
+        /// Adds a call to a script function whose first argument is an entity of the current snapshot.
+        /// </summary>
+        /// <param name="hash">The hashed name of the script function.</param>
+        /// <param name="entity">
+        /// The entity passed as the first argument. Its handle is created right before the call, or is zero if the
+        /// script guid pool is full.
+        /// </param>
+        /// <param name="arguments">The input arguments passed to the script function after the entity.</param>
+        public void Add(Hash hash, FrameEntity entity, params InputArgument[] arguments)
+        {
+            _batch.BeginCall((ulong)hash);
+            _batch.PushArgument(entity.CoreEntity);
+            foreach (InputArgument argument in arguments)
+            {
+                _batch.PushArgument(argument?._data ?? 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,33 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using GTA.Math;
+
+namespace GTA
+{
+    /// <summary>
+    /// The state of a <see cref="Ped"/> or <see cref="Vehicle"/> at the start of a frame, as seen by
+    /// <see cref="Script.Compute"/>.
+    /// </summary>
+    /// <remarks>
+    /// The entity has no handle yet. Pass it to <see cref="DeferredNativeCalls.Add(Native.Hash, FrameEntity, Native.InputArgument[])"/>
+    /// to call a script function on it, which creates the handle on the main thread only for the entities used.
+    /// </remarks>
+    public readonly struct FrameEntity
+    {
+        private readonly SHVDN.FrameEntity _entity;
+
+        internal FrameEntity(in SHVDN.FrameEntity entity)
+        {
+            _entity = entity;
+        }
+
+        internal SHVDN.FrameEntity CoreEntity => _entity;
+
+        public Model Model => new(_entity.ModelHash);
+        public Vector3 Position => new(_entity.Position);
+        public float Health => _entity.Health;
+    }
+}
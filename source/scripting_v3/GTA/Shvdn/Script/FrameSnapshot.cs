@@ -0,0 +1,66 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using GTA.Math;
+
+namespace GTA
+{
+    /// <summary>
+    /// A read-only view of the world taken on the main thread at the start of a frame, which <see cref="Script.Compute"/>
+    /// handlers read instead of calling script functions.
+    /// </summary>
+    /// <remarks>
+    /// The peds and vehicles of a snapshot are stored in buffers that are overwritten in the next frame, so a snapshot
+    /// must not be used after the handler it was passed to returns.
+    /// </remarks>
+    public readonly struct FrameSnapshot
+    {
+        private readonly SHVDN.FrameSnapshot _snapshot;
+
+        internal FrameSnapshot(in SHVDN.FrameSnapshot snapshot)
+        {
+            _snapshot = snapshot;
+        }
+
+        /// <summary>
+        /// Gets the number of frames the script domain has run since scripts were loaded, counting the frames in which no
+        /// <see cref="Script"/> computed.
+        /// </summary>
+        public long FrameCount => _snapshot.FrameCount;
+        /// <summary>
+        /// Gets the game time in milliseconds.
+        /// </summary>
+        public int GameTime => _snapshot.GameTime;
+        /// <summary>
+        /// Gets the time the last frame took in seconds.
+        /// </summary>
+        public float FrameTime => _snapshot.FrameTime;
+        /// <summary>
+        /// Gets the handle of the <see cref="Ped"/> the player controls.
+        /// </summary>
+        public int PlayerPedHandle => _snapshot.PlayerPedHandle;
+        public Vector3 PlayerPosition => new(_snapshot.PlayerPosition);
+
+        /// <summary>
+        /// Gets the number of peds in this snapshot.
+        /// </summary>
+        public int PedCount => _snapshot.PedCount;
+        /// <summary>
+        /// Gets the number of vehicles in this snapshot.
+        /// </summary>
+        public int VehicleCount => _snapshot.VehicleCount;
+
+        /// <summary>
+        /// Gets the state of the ped at the given index.
+        /// </summary>
+        /// <param name="index">The index, from 0 to <see cref="PedCount"/> - 1.</param>
+        public FrameEntity GetPed(int index) => new(in _snapshot.GetPed(index));
+        /// <summary>
+        /// Gets the state of the vehicle at the given index.
+        /// </summary>
+        /// <param name="index">The index, from 0 to <see cref="VehicleCount"/> - 1.</param>
+        public FrameEntity GetVehicle(int index) => new(in _snapshot.GetVehicle(index));
+    }
+}
@@ -17,6 +17,8 @@ namespace GTA
     {
         #region Fields
         ScriptSettings _settings;
+        ComputeEventHandler _compute;
+        DeferredNativeCalls _deferredNativeCalls;
         #endregion
 
         class InstantiateScriptTask : SHVDN.IScriptTask
@@ -66,6 +68,68 @@ namespace GTA
             }
         }
         /// <summary>
+        /// An event that is raised at the start of every frame on a worker thread, in parallel with the same event of
+        /// other scripts, so frame time grows with the work of the slowest script instead of the sum of all of them.
+        /// Handlers must not call script functions, which throws an <see cref="InvalidOperationException"/>. Read the
+        /// world from the given <see cref="FrameSnapshot"/> and add the script functions to call to the given
+        /// <see cref="DeferredNativeCalls"/> instead, which are called on the main thread once all scripts have computed.
+        /// </summary>
+        public event ComputeEventHandler Compute
+        {
+            add
+            {
+                SHVDN.Script script = SHVDN.ScriptDomain.CurrentDomain.LookupScript(this);
+                if (script == null)
+                {
+                    return;
+                }
+
+                if (_compute == null)
+                {
+                    script.Compute += OnCoreCompute;
+                }
+                _compute += value;
+            }
+            remove
+            {
+                SHVDN.Script script = SHVDN.ScriptDomain.CurrentDomain.LookupScript(this);
+                if (script == null || _compute == null)
+                {
+                    return;
+                }
+
+                _compute -= value;
+                if (_compute == null)
+                {
+                    script.Compute -= OnCoreCompute;
+                }
+            }
+        }
+        /// <summary>
+        /// An event that is raised at the start of the tick that follows <see cref="Compute"/>, after the script
+        /// functions added to <see cref="DeferredNativeCalls"/> have been called. Unlike <see cref="Compute"/>, this
+        /// runs on the thread of this <see cref="Script"/> like <see cref="Tick"/>.
+        /// </summary>
+        public event EventHandler Apply
+        {
+            add
+            {
+                SHVDN.Script script = SHVDN.ScriptDomain.CurrentDomain.LookupScript(this);
+                if (script != null)
+                {
+                    script.Apply += value;
+                }
+            }
+            remove
+            {
+                SHVDN.Script script = SHVDN.ScriptDomain.CurrentDomain.LookupScript(this);
+                if (script != null)
+                {
+                    script.Apply -= value;
+                }
+            }
+        }
+        /// <summary>
         /// An event that is raised when this <see cref="Script"/> gets aborted for any reason.
         /// This should be used for cleaning up anything created during this <see cref="Script"/>.
         /// </summary>
@@ -154,6 +218,12 @@ namespace GTA
         /// <summary>
         /// Gets the Directory where this <see cref="Script"/> is stored.
         /// </summary>
+        /// <remarks>
+        /// Script assemblies are loaded from copies in an assembly cache in the temporary directory, so
+        /// <see cref="System.Reflection.Assembly.Location"/> and <see cref="System.Reflection.Assembly.CodeBase"/>
+        /// of the script assembly point into that cache instead of the scripts directory.
+        /// Use this directory to find files that are shipped next to the script.
+        /// </remarks>
         public string BaseDirectory => Path.GetDirectoryName(Filename);
 
         /// <summary>
@@ -171,6 +241,18 @@ namespace GTA
         /// </summary>
         public bool IsExecuting => SHVDN.ScriptDomain.CurrentDomain.LookupScript(this).IsExecuting;
 
+        /// <summary>
+        /// Gets a snapshot of the execution metrics of this <see cref="Script"/>, such as the tick times and the allocated bytes.
+        /// </summary>
+        public ScriptMetrics Metrics
+        {
+            get
+            {
+                SHVDN.Script script = SHVDN.ScriptDomain.CurrentDomain.LookupScript(this);
+                return script != null ? new ScriptMetrics(script.GetMetrics()) : null;
+            }
+        }
+
         /// <summary>
         /// Gets an INI file associated with this <see cref="Script"/>.
         /// The file will be in the same location as this <see cref="Script"/> but with an extension of ".ini".
@@ -280,6 +362,22 @@ namespace GTA
             Wait(0);
         }
 
+        /// <summary>
+        /// Gets snapshots of the execution metrics of all the running scripts, including scripts from other files.
+        /// </summary>
+        public static ScriptMetrics[] GetMetricsOfAllScripts()
+        {
+            SHVDN.ScriptMetricsSnapshot[] snapshots = SHVDN.ScriptDomain.CurrentDomain.GetScriptMetrics();
+
+            var result = new ScriptMetrics[snapshots.Length];
+            for (int i = 0; i < snapshots.Length; i++)
+            {
+                result[i] = new ScriptMetrics(snapshots[i]);
+            }
+
+            return result;
+        }
+
         /// <summary>
         /// Spawns a new <see cref="Script"/> instance of the specified type.
         /// </summary>
@@ -302,5 +400,12 @@ namespace GTA
 
             return (T)task._script.ScriptInstance;
         }
+
+        private void OnCoreCompute(in SHVDN.FrameSnapshot snapshot, SHVDN.NativeCallBatch deferredCalls)
+        {
+            // The core script always passes the same batch, so the wrapper is created once
+            _deferredNativeCalls ??= new DeferredNativeCalls(deferredCalls);
+            _compute?.Invoke(new FrameSnapshot(in snapshot), _deferredNativeCalls);
+        }
     }
 }
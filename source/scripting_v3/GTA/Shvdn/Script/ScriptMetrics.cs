@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+
+namespace GTA
+{
+    /// <summary>
+    /// A snapshot of the execution metrics of a <see cref="Script"/>.
+    /// Averages and percentiles cover the last 256 ticks of the script.
+    /// </summary>
+    public sealed class ScriptMetrics
+    {
+        private readonly SHVDN.ScriptMetricsSnapshot _snapshot;
+
+        internal ScriptMetrics(SHVDN.ScriptMetricsSnapshot snapshot)
+        {
+            _snapshot = snapshot;
+        }
+
+        /// <summary>
+        /// Gets the name of the <see cref="Script"/>.
+        /// </summary>
+        public string ScriptName => _snapshot.ScriptName;
+        /// <summary>
+        /// Gets the path to the file that contains the <see cref="Script"/>.
+        /// </summary>
+        public string Filename => _snapshot.Filename;
+
+        /// <summary>
+        /// Gets the number of ticks the <see cref="Script"/> has executed.
+        /// </summary>
+        public long TickCount => _snapshot.TickCount;
+        /// <summary>
+        /// Gets the number of unhandled exceptions the <see cref="Script"/> has thrown.
+        /// </summary>
+        public int ExceptionCount => _snapshot.ExceptionCount;
+
+        /// <summary>
+        /// Gets the wall time of the last tick, including the time spent in native calls.
+        /// </summary>
+        public TimeSpan LastTickTime => _snapshot.LastTickTime;
+        /// <summary>
+        /// Gets the average wall time of the recent ticks.
+        /// </summary>
+        public TimeSpan AverageTickTime => _snapshot.AverageTickTime;
+        /// <summary>
+        /// Gets the 99th percentile of the wall time of the recent ticks.
+        /// </summary>
+        public TimeSpan P99TickTime => _snapshot.P99TickTime;
+
+        /// <summary>
+        /// Gets the CPU time the thread of the <see cref="Script"/> used in the last tick.
+        /// The OS updates thread times in coarse steps, so prefer <see cref="AverageCpuTime"/> for a single script.
+        /// </summary>
+        public TimeSpan LastCpuTime => _snapshot.LastCpuTime;
+        /// <summary>
+        /// Gets the average CPU time the thread of the <see cref="Script"/> used in the recent ticks.
+        /// </summary>
+        public TimeSpan AverageCpuTime => _snapshot.AverageCpuTime;
+        /// <summary>
+        /// Gets the total CPU time the thread of the <see cref="Script"/> used in its ticks.
+        /// </summary>
+        public TimeSpan TotalCpuTime => _snapshot.TotalCpuTime;
+
+        /// <summary>
+        /// Gets whether the allocated bytes only include allocations of the thread of the <see cref="Script"/>.
+        /// If <see langword="false" />, they include allocations of all the threads in the script domain made while the <see cref="Script"/> was running.
+        /// </summary>
+        public bool IsAllocatedBytesPerThread => _snapshot.IsAllocatedBytesPerThread;
+        /// <summary>
+        /// Gets the number of bytes allocated in the last tick.
+        /// </summary>
+        public long LastAllocatedBytes => _snapshot.LastAllocatedBytes;
+        /// <summary>
+        /// Gets the average number of bytes allocated in the recent ticks.
+        /// </summary>
+        public long AverageAllocatedBytes => _snapshot.AverageAllocatedBytes;
+        /// <summary>
+        /// Gets the total number of bytes allocated in the ticks of the <see cref="Script"/>.
+        /// </summary>
+        public long TotalAllocatedBytes => _snapshot.TotalAllocatedBytes;
+
+        /// <summary>
+        /// Gets the number of native calls in the last tick.
+        /// </summary>
+        public long LastNativeCallCount => _snapshot.LastNativeCallCount;
+        /// <summary>
+        /// Gets the average number of native calls in the recent ticks.
+        /// </summary>
+        public double AverageNativeCallCount => _snapshot.AverageNativeCallCount;
+        /// <summary>
+        /// Gets the total number of native calls in the ticks of the <see cref="Script"/>.
+        /// </summary>
+        public long TotalNativeCallCount => _snapshot.TotalNativeCallCount;
+
+        /// <summary>
+        /// Returns a string that represents this <see cref="ScriptMetrics"/>.
+        /// </summary>
+        public override string ToString()
+        {
+            return $"{ScriptName}: tick {LastTickTime.TotalMilliseconds:F2}/{AverageTickTime.TotalMilliseconds:F2}/{P99TickTime.TotalMilliseconds:F2} ms, " +
+                $"cpu {AverageCpuTime.TotalMilliseconds:F2} ms, alloc {AverageAllocatedBytes / 1024.0:F1} KB, natives {AverageNativeCallCount:F0}";
+        }
+    }
+}
@@ -35,9 +35,18 @@ namespace GTA
         /// <remarks>
         /// If this method cannot load the file due to <see cref="IOException"/>, the created instance will not contain any setting values.
         /// </remarks>
-        public static ScriptSettings Load(string filename)
+        public static ScriptSettings Load(string filename) => Load(filename, out _);
+        /// <summary>
+        /// Loads a <see cref="ScriptSettings"/> from the specified file.
+        /// </summary>
+        /// <param name="filename">The filename to load the settings from.</param>
+        /// <param name="fileIsInaccessible">
+        /// When this method returns, <see langword="true" /> if the file exists but could not be opened, such as when another process is still writing it.
+        /// </param>
+        internal static ScriptSettings Load(string filename, out bool fileIsInaccessible)
         {
             var result = new ScriptSettings(filename);
+            fileIsInaccessible = false;
 
             if (!File.Exists(filename))
             {
@@ -54,6 +63,7 @@ namespace GTA
             }
             catch (IOException)
             {
+                fileIsInaccessible = true;
                 return result;
             }
 
@@ -100,6 +110,41 @@ namespace GTA
             return result;
         }
 
+        /// <summary>
+        /// Binds a section of the specified file to a new instance of <typeparamref name="T"/> and keeps it up to date when the file changes.
+        /// </summary>
+        /// <typeparam name="T">
+        /// The type to bind to. Its public instance fields and properties with a setter are read from the keys of the same name
+        /// (case-insensitive) using <see cref="CultureInfo.InvariantCulture"/>. Supported member types are <see cref="string"/>,
+        /// enums and the types that implement <see cref="IConvertible"/>. Members without a key keep the value set by the parameterless constructor.
+        /// </typeparam>
+        /// <param name="filename">The filename to load the settings from.</param>
+        /// <param name="sectionName">The section to bind.</param>
+        /// <param name="watchForChanges">
+        /// <see langword="true" /> to reload the values when the file changes; <see langword="false" /> to only load them once.
+        /// </param>
+        /// <returns>
+        /// The binding, which should be disposed when your script is aborted if <paramref name="watchForChanges"/> is <see langword="true" />.
+        /// </returns>
+        /// <remarks>
+        /// The member parsers are compiled once per type and reused for every reload. The file is reloaded on a thread pool thread,
+        /// and <see cref="ScriptSettingsBinding{T}.Value"/> is swapped to the new instance atomically, so a script can read it every tick
+        /// without locking and never sees a partially applied change.
+        /// </remarks>
+        public static ScriptSettingsBinding<T> Bind<T>(string filename, string sectionName, bool watchForChanges = true) where T : new()
+        {
+            if (filename == null)
+            {
+                throw new ArgumentNullException(nameof(filename));
+            }
+            if (sectionName == null)
+            {
+                throw new ArgumentNullException(nameof(sectionName));
+            }
+
+            return new ScriptSettingsBinding<T>(Path.GetFullPath(filename), sectionName, watchForChanges);
+        }
+
         /// <summary>
         /// Saves this <see cref="ScriptSettings"/> to file.
         /// </summary>
@@ -500,6 +545,8 @@ namespace GTA
         /// </summary>
         public bool ContainsSection(string section) => _values.ContainsKey(section);
 
+        internal bool TryGetSection(string sectionName, out Dictionary<string, List<string>> keyValuePairs) => _values.TryGetValue(sectionName, out keyValuePairs);
+
         /// <summary>
         /// Gets a value that indicates whether this <see cref="ScriptSettings"/> contains the specified key at the specified section.
         /// </summary>
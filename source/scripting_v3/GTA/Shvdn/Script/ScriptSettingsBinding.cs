@@ -0,0 +1,308 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq.Expressions;
+using System.Reflection;
+using System.Threading;
+
+namespace GTA
+{
+    /// <summary>
+    /// Represents a section of a <see cref="ScriptSettings"/> file bound to an instance of <typeparamref name="T"/>.
+    /// Create one with <see cref="ScriptSettings.Bind{T}(string, string, bool)"/>.
+    /// </summary>
+    /// <typeparam name="T">The type the section is bound to.</typeparam>
+    public sealed class ScriptSettingsBinding<T> : IDisposable where T : new()
+    {
+        // Boxes the value so a struct can be swapped with a single reference write as well
+        private sealed class Snapshot
+        {
+            internal readonly T _value;
+
+            internal Snapshot(T value)
+            {
+                _value = value;
+            }
+        }
+
+        private const int ReloadDelayMilliseconds = 100;
+        private const int MaxReloadRetryCount = 10;
+
+        private static readonly Func<Dictionary<string, List<string>>, T> s_bind = CompileBinder();
+
+        private readonly string _fileName;
+        private readonly string _sectionName;
+        private readonly object _reloadLock = new();
+        private Snapshot _current;
+        private int _version;
+        private FileSystemWatcher _watcher;
+        private Timer _reloadTimer;
+        private int _reloadRetryCount;
+
+        internal ScriptSettingsBinding(string fileName, string sectionName, bool watchForChanges)
+        {
+            _fileName = fileName;
+            _sectionName = sectionName;
+
+            if (!Reload())
+            {
+                // Keep the defaults until the file can be read
+                _current = new Snapshot(new T());
+            }
+
+            string directory = Path.GetDirectoryName(fileName);
+            if (!watchForChanges || !Directory.Exists(directory))
+            {
+                return;
+            }
+
+            _reloadTimer = new Timer(OnReloadTimerElapsed);
+            _watcher = new FileSystemWatcher(directory, Path.GetFileName(fileName))
+            {
+                NotifyFilter = NotifyFilters.LastWrite | NotifyFilters.FileName | NotifyFilters.Size | NotifyFilters.CreationTime,
+            };
+            _watcher.Changed += OnFileChanged;
+            _watcher.Created += OnFileChanged;
+            _watcher.Renamed += OnFileChanged;
+            _watcher.EnableRaisingEvents = true;
+        }
+
+        /// <summary>
+        /// Gets the current values of the bound section.
+        /// </summary>
+        /// <remarks>
+        /// A new instance is created every time the file is reloaded, so do not modify the returned instance.
+        /// Read this property again (e.g. once per tick) to pick up changes.
+        /// </remarks>
+        public T Value => Volatile.Read(ref _current)._value;
+
+        /// <summary>
+        /// Gets a number that is incremented every time <see cref="Value"/> is replaced with newly loaded values.
+        /// </summary>
+        public int Version => Volatile.Read(ref _version);
+
+        /// <summary>
+        /// Gets the full path of the bound file.
+        /// </summary>
+        public string FileName => _fileName;
+
+        /// <summary>
+        /// Gets the name of the bound section.
+        /// </summary>
+        public string SectionName => _sectionName;
+
+        /// <summary>
+        /// Loads the file again and replaces <see cref="Value"/> with the new values.
+        /// </summary>
+        /// <returns>
+        /// <see langword="true" /> if the values were replaced; <see langword="false" /> if the file exists but could not be read,
+        /// in which case <see cref="Value"/> keeps the previous values.
+        /// </returns>
+        public bool Reload()
+        {
+            lock (_reloadLock)
+            {
+                var settings = ScriptSettings.Load(_fileName, out bool fileIsInaccessible);
+                if (fileIsInaccessible)
+                {
+                    return false;
+                }
+
+                settings.TryGetSection(_sectionName, out Dictionary<string, List<string>> keyValuePairs);
+                Volatile.Write(ref _current, new Snapshot(s_bind(keyValuePairs)));
+                Interlocked.Increment(ref _version);
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Stops watching the bound file for changes.
+        /// </summary>
+        public void Dispose()
+        {
+            lock (_reloadLock)
+            {
+                _watcher?.Dispose();
+                _watcher = null;
+                _reloadTimer?.Dispose();
+                _reloadTimer = null;
+            }
+        }
+
+        private void OnFileChanged(object sender, FileSystemEventArgs e)
+        {
+            // Editors usually write a file in several steps, so wait for the events to settle before reading it
+            lock (_reloadLock)
+            {
+                _reloadRetryCount = 0;
+                _reloadTimer?.Change(ReloadDelayMilliseconds, Timeout.Infinite);
+            }
+        }
+
+        private void OnReloadTimerElapsed(object state)
+        {
+            if (Reload())
+            {
+                return;
+            }
+
+            // The file is most likely still opened by the writer, so try again a bit later
+            lock (_reloadLock)
+            {
+                if (++_reloadRetryCount <= MaxReloadRetryCount)
+                {
+                    _reloadTimer?.Change(ReloadDelayMilliseconds, Timeout.Infinite);
+                }
+            }
+        }
+
+        private static Func<Dictionary<string, List<string>>, T> CompileBinder()
+        {
+            ParameterExpression sectionParam = Expression.Parameter(typeof(Dictionary<string, List<string>>), "section");
+            ParameterExpression resultVar = Expression.Variable(typeof(T), "result");
+            ParameterExpression textVar = Expression.Variable(typeof(string), "text");
+            MethodInfo tryGetValueText = typeof(ScriptSettingsValueParser).GetMethod(nameof(ScriptSettingsValueParser.TryGetValueText), BindingFlags.NonPublic | BindingFlags.Static);
+
+            var expressions = new List<Expression> { Expression.Assign(resultVar, Expression.New(typeof(T))) };
+
+            foreach (MemberInfo member in typeof(T).GetMembers(BindingFlags.Public | BindingFlags.Instance))
+            {
+                Type memberType;
+                switch (member)
+                {
+                    case FieldInfo field when !field.IsInitOnly && !field.IsLiteral:
+                        memberType = field.FieldType;
+                        break;
+                    case PropertyInfo property when property.GetSetMethod() != null && property.GetIndexParameters().Length == 0:
+                        memberType = property.PropertyType;
+                        break;
+                    default:
+                        continue;
+                }
+
+                MethodInfo parser = ScriptSettingsValueParser.GetParser(memberType);
+                if (parser == null)
+                {
+                    continue;
+                }
+
+                // if (TryGetValueText(section, "Name", out text) && TryParse(text, out parsed)) result.Name = parsed;
+                ParameterExpression parsedVar = Expression.Variable(memberType, member.Name);
+                expressions.Add(Expression.Block(new[] { parsedVar },
+                    Expression.IfThen(
+                        Expression.AndAlso(
+                            Expression.Call(tryGetValueText, sectionParam, Expression.Constant(member.Name), textVar),
+                            Expression.Call(parser, textVar, parsedVar)),
+                        Expression.Assign(Expression.MakeMemberAccess(resultVar, member), parsedVar))));
+            }
+
+            expressions.Add(resultVar);
+
+            BlockExpression body = Expression.Block(new[] { resultVar, textVar }, expressions);
+            return Expression.Lambda<Func<Dictionary<string, List<string>>, T>>(body, sectionParam).Compile();
+        }
+    }
+
+    /// <summary>
+    /// Provides the value parsers for <see cref="ScriptSettingsBinding{T}"/>. All of them parse using <see cref="CultureInfo.InvariantCulture"/>.
+    /// </summary>
+    internal static class ScriptSettingsValueParser
+    {
+        internal static bool TryGetValueText(Dictionary<string, List<string>> section, string keyName, out string text)
+        {
+            if (section != null && section.TryGetValue(keyName, out List<string> valueList) && valueList.Count > 0)
+            {
+                text = valueList[0];
+                return true;
+            }
+
+            text = null;
+            return false;
+        }
+
+        internal static MethodInfo GetParser(Type type)
+        {
+            const BindingFlags Flags = BindingFlags.NonPublic | BindingFlags.Static;
+
+            if (type == typeof(string))
+            {
+                return typeof(ScriptSettingsValueParser).GetMethod(nameof(TryParseString), Flags);
+            }
+            if (type == typeof(bool))
+            {
+                return typeof(ScriptSettingsValueParser).GetMethod(nameof(TryParseBoolean), Flags);
+            }
+            if (type == typeof(int))
+            {
+                return typeof(ScriptSettingsValueParser).GetMethod(nameof(TryParseInt32), Flags);
+            }
+            if (type == typeof(float))
+            {
+                return typeof(ScriptSettingsValueParser).GetMethod(nameof(TryParseSingle), Flags);
+            }
+            if (type == typeof(double))
+            {
+                return typeof(ScriptSettingsValueParser).GetMethod(nameof(TryParseDouble), Flags);
+            }
+            if (type.IsEnum)
+            {
+                return typeof(ScriptSettingsValueParser).GetMethod(nameof(TryParseEnum), Flags).MakeGenericMethod(type);
+            }
+            if (typeof(IConvertible).IsAssignableFrom(type))
+            {
+                return typeof(ScriptSettingsValueParser).GetMethod(nameof(TryParseConvertible), Flags).MakeGenericMethod(type);
+            }
+
+            return null;
+        }
+
+        private static bool TryParseString(string text, out string value)
+        {
+            value = text;
+            return true;
+        }
+        private static bool TryParseBoolean(string text, out bool value)
+        {
+            if (bool.TryParse(text, out value))
+            {
+                return true;
+            }
+
+            // Accept the numeric form too, which is common in ini files
+            if (int.TryParse(text, NumberStyles.Integer, CultureInfo.InvariantCulture, out int number))
+            {
+                value = number != 0;
+                return true;
+            }
+
+            return false;
+        }
+        private static bool TryParseInt32(string text, out int value)
+            => int.TryParse(text, NumberStyles.Integer, CultureInfo.InvariantCulture, out value);
+        private static bool TryParseSingle(string text, out float value)
+            => float.TryParse(text, NumberStyles.Float | NumberStyles.AllowThousands, CultureInfo.InvariantCulture, out value);
+        private static bool TryParseDouble(string text, out double value)
+            => double.TryParse(text, NumberStyles.Float | NumberStyles.AllowThousands, CultureInfo.InvariantCulture, out value);
+        private static bool TryParseEnum<TEnum>(string text, out TEnum value) where TEnum : struct
+            => Enum.TryParse(text, true, out value);
+        private static bool TryParseConvertible<TValue>(string text, out TValue value)
+        {
+            try
+            {
+                value = (TValue)Convert.ChangeType(text, typeof(TValue), CultureInfo.InvariantCulture);
+                return true;
+            }
+            catch (Exception)
+            {
+                value = default(TValue);
+                return false;
+            }
+        }
+    }
+}
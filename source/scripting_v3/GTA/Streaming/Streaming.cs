@@ -1,5 +1,7 @@
 using GTA.Math;
 using GTA.Native;
+using System;
+using System.Collections.Generic;
 
 namespace GTA
 {
@@ -171,5 +173,93 @@ namespace GTA
         /// </summary>
         /// <param name="amount">The budget amount to allocate from 0 to 3, with 0 being none and 3 being normal.</param>
         public static void SetVehiclePopulationBudget(int amount) => Function.Call(Hash.SET_VEHICLE_POPULATION_BUDGET, amount);
+
+        /// <summary>
+        /// Gets a snapshot of the queue depth and load times of the assets requested through
+        /// <see cref="IScriptStreamingResource"/>s by all <see cref="Script"/>s.
+        /// </summary>
+        public static StreamingStatistics GetStatistics()
+            => new(SHVDN.ScriptDomain.CurrentDomain.GetStreamingStatistics());
+
+        /// <summary>
+        /// Starts loading <see cref="Model"/>s you will need soon, such as the models of the next spawn wave, without
+        /// holding them. <see cref="Model.Request(int)"/> does not need to wait for a prefetched <see cref="Model"/>
+        /// that has finished loading.
+        /// </summary>
+        /// <param name="models">The <see cref="Model"/>s to load.</param>
+        /// <param name="keepAliveMilliseconds">
+        /// How long the <see cref="Model"/>s are kept loaded if no <see cref="Script"/> requests them.
+        /// </param>
+        public static void Prefetch(IEnumerable<Model> models, int keepAliveMilliseconds = 10000)
+        {
+            if (models == null)
+            {
+                throw new ArgumentNullException(nameof(models));
+            }
+
+            foreach (Model model in models)
+            {
+                SHVDN.ScriptDomain.CurrentDomain.PrefetchStreamingAsset(SHVDN.StreamingAssetType.Model, model.Hash, null, keepAliveMilliseconds);
+            }
+        }
+        /// <summary>
+        /// Starts loading a <see cref="Model"/> you will need soon without holding it.
+        /// </summary>
+        /// <param name="model">The <see cref="Model"/> to load.</param>
+        /// <param name="keepAliveMilliseconds">
+        /// How long the <see cref="Model"/> is kept loaded if no <see cref="Script"/> requests it.
+        /// </param>
+        public static StreamingRequest Prefetch(Model model, int keepAliveMilliseconds = 10000)
+            => new(SHVDN.ScriptDomain.CurrentDomain.PrefetchStreamingAsset(SHVDN.StreamingAssetType.Model, model.Hash, null, keepAliveMilliseconds));
+        /// <summary>
+        /// Starts loading a <see cref="ClipSet"/> you will need soon without holding it.
+        /// </summary>
+        /// <param name="clipSet">The <see cref="ClipSet"/> to load.</param>
+        /// <param name="keepAliveMilliseconds">
+        /// How long the <see cref="ClipSet"/> is kept loaded if no <see cref="Script"/> requests it.
+        /// </param>
+        public static StreamingRequest Prefetch(ClipSet clipSet, int keepAliveMilliseconds = 10000)
+            => new(SHVDN.ScriptDomain.CurrentDomain.PrefetchStreamingAsset(SHVDN.StreamingAssetType.ClipSet, 0, clipSet.Name, keepAliveMilliseconds));
+        /// <summary>
+        /// Starts loading a <see cref="CrClipDictionary"/> you will need soon without holding it.
+        /// </summary>
+        /// <param name="clipDict">The <see cref="CrClipDictionary"/> to load.</param>
+        /// <param name="keepAliveMilliseconds">
+        /// How long the <see cref="CrClipDictionary"/> is kept loaded if no <see cref="Script"/> requests it.
+        /// </param>
+        public static StreamingRequest Prefetch(CrClipDictionary clipDict, int keepAliveMilliseconds = 10000)
+            => new(SHVDN.ScriptDomain.CurrentDomain.PrefetchStreamingAsset(SHVDN.StreamingAssetType.ClipDictionary, 0, clipDict.Name, keepAliveMilliseconds));
+
+        internal static SHVDN.StreamingRequest Acquire(SHVDN.StreamingAssetType assetType, int hash, string name)
+            => SHVDN.ScriptDomain.CurrentDomain.AcquireStreamingAsset(assetType, hash, name);
+
+        internal static bool Release(SHVDN.StreamingAssetType assetType, int hash, string name)
+            => SHVDN.ScriptDomain.CurrentDomain.ReleaseStreamingAsset(assetType, hash, name);
+
+        internal static bool Wait(SHVDN.StreamingRequest request, int timeout)
+        {
+            int startTime = Environment.TickCount;
+            int maxElapsedTime = timeout >= 0 ? timeout : int.MaxValue;
+
+            // The script domain polls the request once per frame for all waiting scripts and sets it back to pending if
+            // something else unloaded the asset
+            while (!request.IsLoaded)
+            {
+                // Completed without being loaded means the asset does not exist or nobody holds it anymore
+                if (request.IsCompleted)
+                {
+                    return false;
+                }
+
+                Script.Yield();
+
+                if (Environment.TickCount - startTime >= maxElapsedTime)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
     }
 }
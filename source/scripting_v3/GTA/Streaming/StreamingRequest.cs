@@ -0,0 +1,102 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+using System.Runtime.CompilerServices;
+
+namespace GTA
+{
+    /// <summary>
+    /// Represents the request for a streaming asset, which is shared by all the <see cref="Script"/>s that requested
+    /// the same asset.
+    /// </summary>
+    /// <remarks>
+    /// The pending requests are polled once per frame for all <see cref="Script"/>s, before any of them ticks.
+    /// You can <see langword="await"/> a <see cref="StreamingRequest"/> or register a callback with
+    /// <see cref="OnCompleted(Action{bool})"/>. Both run at the start of the next tick of the waiting <see cref="Script"/>
+    /// once the request completes, on the thread that runs the <see cref="Script"/>.
+    /// </remarks>
+    public sealed class StreamingRequest
+    {
+        private readonly SHVDN.StreamingRequest _request;
+
+        internal StreamingRequest(SHVDN.StreamingRequest request)
+        {
+            _request = request;
+        }
+
+        /// <summary>
+        /// Gets a value indicating whether the asset has either been loaded or failed to load.
+        /// </summary>
+        public bool IsCompleted => _request.IsCompleted;
+        /// <summary>
+        /// Gets a value indicating whether the asset has been loaded.
+        /// </summary>
+        public bool IsLoaded => _request.IsLoaded;
+        /// <summary>
+        /// Gets a value indicating whether the asset does not exist and cannot be loaded.
+        /// </summary>
+        public bool IsFailed => _request.IsFailed;
+
+        /// <summary>
+        /// Gets the number of <see cref="Script"/>s that hold the asset. The asset is unloaded after the last of them
+        /// marked it as no longer needed.
+        /// </summary>
+        public int HolderCount => _request.HolderCount;
+
+        /// <summary>
+        /// Gets how long it took to load the asset, or <see cref="TimeSpan.Zero"/> if it is not loaded yet.
+        /// </summary>
+        public TimeSpan LoadTime => _request.LoadTime;
+
+        /// <summary>
+        /// Registers a method that is called with whether the asset was loaded once this request completes.
+        /// The method is called at the start of the next tick of the executing <see cref="Script"/>, even if this
+        /// request has already completed.
+        /// </summary>
+        /// <param name="handler">The method to call.</param>
+        /// <exception cref="InvalidOperationException">Not called from a <see cref="Script"/>.</exception>
+        public void OnCompleted(Action<bool> handler)
+        {
+            _request.OnCompleted(handler);
+        }
+
+        /// <summary>
+        /// Waits for this request to complete for a given period of time, yielding the executing <see cref="Script"/>
+        /// every tick.
+        /// </summary>
+        /// <param name="timeout">The time (in milliseconds) before giving up waiting (-1 for no timeout).</param>
+        /// <returns><see langword="true" /> if the asset is loaded; otherwise, <see langword="false" />.</returns>
+        public bool Wait(int timeout)
+        {
+            return Streaming.Wait(_request, timeout);
+        }
+
+        public Awaiter GetAwaiter() => new(_request.GetAwaiter());
+
+        /// <summary>
+        /// Allows <see cref="Script"/>s to <see langword="await"/> a <see cref="StreamingRequest"/>.
+        /// The result is whether the asset was loaded.
+        /// </summary>
+        public readonly struct Awaiter : INotifyCompletion
+        {
+            private readonly SHVDN.StreamingRequestAwaiter _awaiter;
+
+            internal Awaiter(SHVDN.StreamingRequestAwaiter awaiter)
+            {
+                _awaiter = awaiter;
+            }
+
+            public bool IsCompleted => _awaiter.IsCompleted;
+
+            public bool GetResult() => _awaiter.GetResult();
+
+            public void OnCompleted(Action continuation)
+            {
+                _awaiter.OnCompleted(continuation);
+            }
+        }
+    }
+}
@@ -0,0 +1,47 @@
+//
+// Copyright (C) 2015 crosire & kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using System;
+
+namespace GTA
+{
+    /// <summary>
+    /// A snapshot of the streaming requests made through <see cref="IScriptStreamingResource"/>s by all <see cref="Script"/>s.
+    /// </summary>
+    public sealed class StreamingStatistics
+    {
+        private readonly SHVDN.StreamingStatisticsSnapshot _snapshot;
+
+        internal StreamingStatistics(SHVDN.StreamingStatisticsSnapshot snapshot)
+        {
+            _snapshot = snapshot;
+        }
+
+        /// <summary>
+        /// Gets the number of assets that have been requested but are not loaded yet.
+        /// </summary>
+        public int QueueDepth => _snapshot.QueueDepth;
+        /// <summary>
+        /// Gets the number of assets that are held by at least one <see cref="Script"/> or prefetched.
+        /// </summary>
+        public int RequestCount => _snapshot.RequestCount;
+        /// <summary>
+        /// Gets the number of assets that have been loaded since scripts were loaded.
+        /// </summary>
+        public long CompletedLoadCount => _snapshot.CompletedLoadCount;
+        /// <summary>
+        /// Gets the number of requested assets that turned out not to exist since scripts were loaded.
+        /// </summary>
+        public long FailedLoadCount => _snapshot.FailedLoadCount;
+        /// <summary>
+        /// Gets the average time it took to load an asset.
+        /// </summary>
+        public TimeSpan AverageLoadTime => _snapshot.AverageLoadTime;
+        /// <summary>
+        /// Gets the longest time it took to load an asset.
+        /// </summary>
+        public TimeSpan MaxLoadTime => _snapshot.MaxLoadTime;
+    }
+}
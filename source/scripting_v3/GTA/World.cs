@@ -429,6 +429,32 @@ namespace GTA
             return Array.ConvertAll(SHVDN.NativeMemory.GetNonCriticalRadarBlipHandles(position.ToInternalFVector3(), radius, blipTypesInt), handle => new Blip(handle));
         }
 
+        /// <summary>
+        /// Enumerates all the <see cref="Blip"/>s on the map without allocating an <c>array</c>.
+        /// </summary>
+        /// <param name="filter">The sprites of the <see cref="Blip"/>s to include, or <see langword="null" /> to include every <see cref="Blip"/>.</param>
+        public static BlipEnumerable EnumerateBlips(BlipSpriteFilter filter = null)
+        {
+            return new BlipEnumerable(null, 0f, filter?.Mask);
+        }
+        /// <summary>
+        /// Enumerates all the <see cref="Blip"/>s in a given region in the World without allocating an <c>array</c>.
+        /// </summary>
+        /// <param name="position">The position to check the <see cref="Blip"/> against.</param>
+        /// <param name="radius">The maximum distance from the <paramref name="position"/> to detect <see cref="Blip"/>s.</param>
+        /// <param name="filter">The sprites of the <see cref="Blip"/>s to include, or <see langword="null" /> to include every <see cref="Blip"/>.</param>
+        public static BlipEnumerable EnumerateNearbyBlips(Vector3 position, float radius, BlipSpriteFilter filter = null)
+        {
+            return new BlipEnumerable(position.ToInternalFVector3(), radius, filter?.Mask);
+        }
+
+        /// <summary>
+        /// Gets a number that changes whenever a <see cref="Blip"/> is created or deleted.
+        /// Store it after reading the <see cref="Blip"/>s and compare it in the next tick to skip the work if nothing
+        /// changed. Changes to the properties of existing <see cref="Blip"/>s, such as their position, do not change it.
+        /// </summary>
+        public static int BlipGeneration => SHVDN.NativeMemory.GetRadarBlipGeneration();
+
         /// <summary>
         /// Creates a <see cref="Blip"/> at the given position on the map.
         /// </summary>
@@ -1535,6 +1561,20 @@ namespace GTA
             return Array.ConvertAll(SHVDN.NativeMemory.GetCheckpointHandles(), element => new Checkpoint(element));
         }
 
+        /// <summary>
+        /// Enumerates all the <see cref="Checkpoint"/>s without allocating an <c>array</c>.
+        /// </summary>
+        public static CheckpointEnumerable EnumerateCheckpoints()
+        {
+            return default;
+        }
+
+        /// <summary>
+        /// Gets a number that changes whenever a <see cref="Checkpoint"/> is created or deleted, so scripts can skip
+        /// work when it is the same as in their previous tick.
+        /// </summary>
+        public static int CheckpointGeneration => SHVDN.NativeMemory.GetCheckpointGeneration();
+
         /// <summary>
         /// Creates a <see cref="Checkpoint"/> in the world.
         /// </summary>
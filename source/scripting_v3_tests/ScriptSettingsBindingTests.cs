@@ -0,0 +1,100 @@
+//
+// Copyright (C) 2023 kagikn & contributors
+// License: https://github.com/scripthookvdotnet/scripthookvdotnet#license
+//
+
+using Xunit;
+using GTA;
+using System;
+using System.IO;
+
+namespace ScriptHookVDotNet_APIv3_Tests
+{
+    public class ScriptSettingsBindingTests : IDisposable
+    {
+        public enum TestMode
+        {
+            Off,
+            Fast,
+        }
+
+        public class TestSettings
+        {
+            public int Count = 5;
+            public float Speed { get; set; } = 1f;
+            public string Name = "default";
+            public TestMode Mode;
+            public bool Enabled;
+            public long Big;
+            public readonly int ReadOnlyValue = 3;
+        }
+
+        public struct TestStructSettings
+        {
+            public int Value;
+        }
+
+        private readonly string _fileName = Path.GetTempFileName();
+
+        public void Dispose()
+        {
+            File.Delete(_fileName);
+        }
+
+        [Fact]
+        public void Bind_parses_members_with_invariant_culture()
+        {
+            File.WriteAllText(_fileName, "[Main]\ncount = 42\nspeed = 2.5\nmode = fast\nenabled = 1\nbig = 123456789012\n");
+
+            using ScriptSettingsBinding<TestSettings> binding = ScriptSettings.Bind<TestSettings>(_fileName, "Main", false);
+            TestSettings value = binding.Value;
+
+            Assert.Equal(42, value.Count);
+            Assert.Equal(2.5f, value.Speed);
+            Assert.Equal(TestMode.Fast, value.Mode);
+            Assert.True(value.Enabled);
+            Assert.Equal(123456789012L, value.Big);
+        }
+
+        [Fact]
+        public void Bind_keeps_constructor_values_for_missing_or_invalid_keys()
+        {
+            File.WriteAllText(_fileName, "[Main]\ncount = not a number\nreadonlyvalue = 10\n");
+
+            using ScriptSettingsBinding<TestSettings> binding = ScriptSettings.Bind<TestSettings>(_fileName, "Main", false);
+            TestSettings value = binding.Value;
+
+            Assert.Equal(5, value.Count);
+            Assert.Equal(1f, value.Speed);
+            Assert.Equal("default", value.Name);
+            Assert.Equal(3, value.ReadOnlyValue);
+        }
+
+        [Fact]
+        public void Bind_supports_structs()
+        {
+            File.WriteAllText(_fileName, "[Other]\nvalue = 7\n");
+
+            using ScriptSettingsBinding<TestStructSettings> binding = ScriptSettings.Bind<TestStructSettings>(_fileName, "Other", false);
+
+            Assert.Equal(7, binding.Value.Value);
+        }
+
+        [Fact]
+        public void Reload_replaces_value_with_new_instance()
+        {
+            File.WriteAllText(_fileName, "[Main]\ncount = 1\n");
+            using ScriptSettingsBinding<TestSettings> binding = ScriptSettings.Bind<TestSettings>(_fileName, "Main", false);
+            TestSettings oldValue = binding.Value;
+            int oldVersion = binding.Version;
+
+            File.WriteAllText(_fileName, "[Main]\ncount = 2\n");
+
+            Assert.True(binding.Reload());
+            Assert.NotSame(oldValue, binding.Value);
+            Assert.Equal(1, oldValue.Count);
+            Assert.Equal(2, binding.Value.Count);
+            Assert.Equal(oldVersion + 1, binding.Version);
+        }
+    }
+}